@@ -0,0 +1,36 @@
+#include "account_index.hpp"
+
+// Looks the account up once and returns its run of rows
+const int* AccountIndex::find(const std::string& account, int& count) const {
+    std::unordered_map<std::string, int>::const_iterator entry = slots.find(account);
+    if (entry == slots.end()) {
+        count = 0;
+        return nullptr;
+    }
+    count = start[entry->second + 1] - start[entry->second];
+    return rows.data() + start[entry->second];
+}
+
+// Swaps with empty containers so the memory is released, not just emptied
+void AccountIndex::clear() {
+    std::unordered_map<std::string, int>().swap(slots);
+    std::vector<int>().swap(start);
+    std::vector<int>().swap(rows);
+}
+
+int AccountIndex::accountCount() const {
+    return (int)slots.size();
+}
+
+// Each hash node holds the key/value pair, a next pointer and a cached hash;
+// keys longer than the short-string buffer also own a heap allocation
+size_t AccountIndex::byteSize() const {
+    size_t nodeBytes = sizeof(std::pair<const std::string, int>) + 2 * sizeof(void*);
+    size_t bytes = slots.size() * nodeBytes + slots.bucket_count() * sizeof(void*);
+    size_t inlineCapacity = std::string().capacity();
+    for (std::unordered_map<std::string, int>::const_iterator it = slots.begin(); it != slots.end(); ++it) {
+        if (it->first.capacity() > inlineCapacity) bytes += it->first.capacity() + 1;
+    }
+    bytes += (start.capacity() + rows.capacity()) * sizeof(int);
+    return bytes;
+}
@@ -0,0 +1,63 @@
+#ifndef ACCOUNT_INDEX_HPP
+#define ACCOUNT_INDEX_HPP
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <cstddef>
+
+// Hash index from an account to the rows that mention it. Rows are stored
+// grouped by account (CSR layout): one hash lookup finds a contiguous run of
+// row numbers, so a lookup costs O(1) + O(k) for an account with k rows,
+// instead of a scan over all N rows. Rows keep their ascending order.
+class AccountIndex {
+private:
+    std::unordered_map<std::string, int> slots; // Account -> slot
+    std::vector<int> start;                     // Rows of slot s: rows[start[s] .. start[s + 1])
+    std::vector<int> rows;
+
+public:
+    // Index rows 0 .. count - 1; accountAt(i) returns the account of row i
+    template <typename AccountAt>
+    void build(int count, AccountAt accountAt);
+
+    // Rows of account as a pointer into the index (nullptr and 0 if unknown)
+    const int* find(const std::string& account, int& count) const;
+
+    // Drop the index and free its memory
+    void clear();
+
+    // Number of distinct accounts
+    int accountCount() const;
+
+    // Estimated memory held by the index (hash nodes, buckets, keys and row arrays)
+    size_t byteSize() const;
+};
+
+// Two passes: give each account a slot and count its rows, then place each
+// row number at its slot's next free position (a counting sort by slot)
+template <typename AccountAt>
+void AccountIndex::build(int count, AccountAt accountAt) {
+    clear();
+    std::vector<int> slotOfRow(count);
+    std::vector<int> rowsPerSlot;
+    for (int i = 0; i < count; ++i) {
+        std::pair<std::unordered_map<std::string, int>::iterator, bool> entry =
+            slots.insert(std::make_pair(accountAt(i), (int)rowsPerSlot.size()));
+        if (entry.second) rowsPerSlot.push_back(0);
+        slotOfRow[i] = entry.first->second;
+        rowsPerSlot[slotOfRow[i]]++;
+    }
+
+    start.assign(rowsPerSlot.size() + 1, 0);
+    for (size_t s = 0; s < rowsPerSlot.size(); ++s) {
+        start[s + 1] = start[s] + rowsPerSlot[s];
+    }
+    std::vector<int> next(start.begin(), start.end() - 1);
+    rows.resize(count);
+    for (int i = 0; i < count; ++i) {
+        rows[next[slotOfRow[i]]++] = i;
+    }
+}
+
+#endif // ACCOUNT_INDEX_HPP
@@ -0,0 +1,126 @@
+#include "array_selection.hpp"
+#include "array_store.hpp"
+#include <iostream> // For display
+#include <utility>
+
+// Constructor: keeps a pointer to the parent and takes over the positions
+ArraySelection::ArraySelection(const ArrayStore& store, std::vector<int> positions)
+    : parent(&store), rows(std::move(positions)) {}
+
+// Returns the parent's row at the given position of the selection
+const Transaction& ArraySelection::at(int index) const {
+    return parent->at(rows[index]);
+}
+
+const std::vector<int>& ArraySelection::getRows() const {
+    return rows;
+}
+
+const ArrayStore& ArraySelection::getParent() const {
+    return *parent;
+}
+
+int ArraySelection::getSize() const {
+    return (int)rows.size();
+}
+
+// Scans only the selected rows; the result shares the parent
+template <typename Predicate>
+ArraySelection ArraySelection::filter(Predicate keep) const {
+    std::vector<int> kept;
+    for (size_t i = 0; i < rows.size(); ++i) {
+        if (keep(parent->at(rows[i]))) {
+            kept.push_back(rows[i]);
+        }
+    }
+    return ArraySelection(*parent, std::move(kept));
+}
+
+// Narrows by payment channel (dictionary codes, an unknown channel matches nothing)
+ArraySelection ArraySelection::groupByPaymentChannel(const std::string& channel) const {
+    int code = dictionaryFor(COL_PAYMENT_CHANNEL).find(channel);
+    return filter([code](const Transaction& t) { return t.payment_channel == code; });
+}
+
+// Narrows by transaction type (dictionary codes, an unknown type matches nothing)
+ArraySelection ArraySelection::searchByTransactionType(const std::string& type) const {
+    int code = dictionaryFor(COL_TRANSACTION_TYPE).find(type);
+    return filter([code](const Transaction& t) { return t.transaction_type == code; });
+}
+
+// Narrows to fraudulent transactions
+ArraySelection ArraySelection::getFraudulentTransactions() const {
+    return filter([](const Transaction& t) { return t.is_fraud; });
+}
+
+// Tests only the selected rows
+ArraySelection ArraySelection::where(const Query& query) const {
+    return ArraySelection(*parent, parent->queryRows(query, rows.data(), (int)rows.size()));
+}
+
+// Copies the selected rows, sized to the selection rather than the parent
+ArrayStore ArraySelection::materialize() const {
+    ArrayStore copy(rows.empty() ? 1 : (int)rows.size());
+    for (size_t i = 0; i < rows.size(); ++i) {
+        copy.addTransaction(parent->at(rows[i]));
+    }
+    return copy;
+}
+
+// Exports the selected transactions to JSON format
+nlohmann::json ArraySelection::toJSON() const {
+    nlohmann::json j_array = nlohmann::json::array();
+    for (size_t i = 0; i < rows.size(); ++i) {
+        j_array.push_back(transactionToJSON(parent->at(rows[i])));
+    }
+    return j_array;
+}
+
+// Streams the selected transactions to a JSON file
+bool ArraySelection::exportJSON(const std::string& path, const JsonExportOptions& options) const {
+    TransactionJsonExporter exporter(options);
+    if (!exporter.open(path)) return false;
+    exporter.addRows(getSize(), [this](int i) -> const Transaction& { return at(i); }, options.threads);
+    return exporter.close();
+}
+
+// Writes the selected transactions to a CSV file
+bool ArraySelection::exportCSV(const std::string& path, int numThreads) const {
+    TransactionCsvExporter exporter;
+    if (!exporter.open(path)) return false;
+    exporter.addRows(getSize(), [this](int i) -> const Transaction& { return at(i); }, numThreads);
+    return exporter.close();
+}
+
+// Displays the selected transactions (same layout as ArrayStore::display)
+void ArraySelection::display() const {
+    std::cout << "\n--- Transactions (Array) ---\n";
+    
+    int size = getSize();
+    int displayCount = (size > 10) ? 10 : size;
+    for (int i = 0; i < displayCount; ++i) {
+        printTransaction(at(i));
+    }
+    
+    // If there are more transactions, ask user if they want to see all
+    if (size > 10) {
+        std::cout << "... and " << (size - 10) << " more transactions\n";
+        std::cout << "Total: " << size << " transactions\n";
+        std::cout << "Show all transactions? (y/n): ";
+        
+        char choice;
+        std::cin >> choice;
+        
+        if (choice == 'y' || choice == 'Y') {
+            std::cout << "\n--- ALL TRANSACTIONS (Array) ---\n";
+            for (int i = 0; i < size; ++i) {
+                printTransaction(at(i));
+            }
+            std::cout << "Total: " << size << " transactions\n";
+        }
+    } else {
+        std::cout << "Total: " << size << " transactions\n";
+    }
+    
+    std::cout << "-------------------\n";
+}
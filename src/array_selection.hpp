@@ -0,0 +1,72 @@
+#ifndef ARRAY_SELECTION_HPP
+#define ARRAY_SELECTION_HPP
+
+#include <string>
+#include <vector>
+#include "../lib/json.hpp" // For JSON export
+#include "json_writer.hpp"
+#include "csv_writer.hpp"
+#include "transaction.hpp"
+
+class ArrayStore;
+class Query;
+
+// Filtered rows of an ArrayStore without copying them: the parent array plus
+// a selection vector of row positions, in parent order. Selections can be
+// filtered again (chained), counted, displayed and exported like the array.
+// The parent must outlive the selection and must not be changed (added to or
+// sorted) while the selection is in use.
+class ArraySelection {
+private:
+    const ArrayStore* parent; // Array the rows belong to
+    std::vector<int> rows;    // Positions of the selected rows in the parent
+
+    // Keep the selected rows that satisfy keep(t)
+    template <typename Predicate>
+    ArraySelection filter(Predicate keep) const;
+
+public:
+    // Constructor: the given positions of store
+    ArraySelection(const ArrayStore& store, std::vector<int> positions);
+
+    // Access a selected transaction by its position in the selection
+    const Transaction& at(int index) const;
+
+    // Positions of the selected rows in the parent array
+    const std::vector<int>& getRows() const;
+
+    // The array the rows are selected from
+    const ArrayStore& getParent() const;
+
+    // Narrow the selection by payment channel (returns a new selection)
+    ArraySelection groupByPaymentChannel(const std::string& channel) const;
+
+    // Narrow the selection by transaction type (returns a new selection)
+    ArraySelection searchByTransactionType(const std::string& type) const;
+
+    // Narrow the selection to fraudulent transactions (returns a new selection)
+    ArraySelection getFraudulentTransactions() const;
+
+    // Narrow the selection to rows matching every predicate of query
+    ArraySelection where(const Query& query) const;
+
+    // Copy the selected rows into a new, independent ArrayStore
+    ArrayStore materialize() const;
+
+    // Export the selected transactions to JSON (same format as ArrayStore)
+    nlohmann::json toJSON() const;
+
+    // Stream the selected transactions to a JSON file (see ArrayStore::exportJSON)
+    bool exportJSON(const std::string& path, const JsonExportOptions& options = JsonExportOptions()) const;
+
+    // Write the selected transactions to a CSV file (see ArrayStore::exportCSV)
+    bool exportCSV(const std::string& path, int numThreads = 0) const;
+
+    // Display the selected transactions to console
+    void display() const;
+
+    // Get the number of selected transactions
+    int getSize() const;
+};
+
+#endif // ARRAY_SELECTION_HPP
@@ -1,14 +1,20 @@
 // Initial commit message: I added this after finishing the array data structure
 #include "array_store.hpp"
 #include "transaction.hpp"
+#include "timestamp.hpp"
+#include "parallel_sort.hpp"
+#include "sort_key.hpp"
 #include <iostream> // For display
-#include <map>
+#include <utility>
+#include <algorithm>
 
 // Constructor: initializes the array with a given maximum size
 ArrayStore::ArrayStore(int max_size) {
     capacity = max_size;
     size = 0;
     transactions = new Transaction[capacity]; // Dynamically allocate array
+    timeIndexValid = false;
+    accountIndexValid = false;
 }
 
 // Destructor: releases the memory used by the array
@@ -16,24 +22,111 @@ ArrayStore::~ArrayStore() {
     delete[] transactions;
 }
 
+// Copy constructor: creates a deep copy of another array
+ArrayStore::ArrayStore(const ArrayStore& other) {
+    capacity = other.capacity;
+    size = other.size;
+    transactions = new Transaction[capacity];
+    for (int i = 0; i < size; ++i) {
+        transactions[i] = other.transactions[i];
+    }
+    // the copy has the same row order, so the indexes still apply
+    timeKeys = other.timeKeys;
+    timeRows = other.timeRows;
+    timeIndexValid = other.timeIndexValid;
+    senderIndex = other.senderIndex;
+    receiverIndex = other.receiverIndex;
+    accountIndexValid = other.accountIndexValid;
+}
+
+// Assignment operator: replaces the contents with a deep copy
+ArrayStore& ArrayStore::operator=(const ArrayStore& other) {
+    if (this != &other) {
+        ArrayStore copy(other);
+        *this = std::move(copy);
+    }
+    return *this;
+}
+
+// Move constructor: takes over the other array, leaving it empty
+ArrayStore::ArrayStore(ArrayStore&& other) {
+    capacity = other.capacity;
+    size = other.size;
+    transactions = other.transactions;
+    timeKeys = std::move(other.timeKeys);
+    timeRows = std::move(other.timeRows);
+    timeIndexValid = other.timeIndexValid;
+    senderIndex = std::move(other.senderIndex);
+    receiverIndex = std::move(other.receiverIndex);
+    accountIndexValid = other.accountIndexValid;
+    other.capacity = 0;
+    other.size = 0;
+    other.transactions = nullptr;
+    other.invalidateIndexes();
+}
+
+// Move assignment: releases our array and takes over the other one
+ArrayStore& ArrayStore::operator=(ArrayStore&& other) {
+    if (this != &other) {
+        delete[] transactions;
+        capacity = other.capacity;
+        size = other.size;
+        transactions = other.transactions;
+        timeKeys = std::move(other.timeKeys);
+        timeRows = std::move(other.timeRows);
+        timeIndexValid = other.timeIndexValid;
+        senderIndex = std::move(other.senderIndex);
+        receiverIndex = std::move(other.receiverIndex);
+        accountIndexValid = other.accountIndexValid;
+        other.capacity = 0;
+        other.size = 0;
+        other.transactions = nullptr;
+        other.invalidateIndexes();
+    }
+    return *this;
+}
+
+// Grows the array to hold at least min_capacity transactions
+void ArrayStore::reserve(int min_capacity) {
+    if (min_capacity <= capacity) return;
+    Transaction* new_transactions = new Transaction[min_capacity];
+    // Move old data (the old array is discarded anyway)
+    for (int i = 0; i < size; ++i) {
+        new_transactions[i] = std::move(transactions[i]);
+    }
+    delete[] transactions;
+    transactions = new_transactions;
+    capacity = min_capacity;
+}
+
 // Adds a transaction to the array
 void ArrayStore::addTransaction(const Transaction& t) {
     if (size >= capacity) {
         // Double the capacity
         int new_capacity = capacity * 2;
         if (new_capacity == 0) new_capacity = 1; // Handle initial case
-        Transaction* new_transactions = new Transaction[new_capacity];
-        // Copy old data
-        for (int i = 0; i < size; ++i) {
-            new_transactions[i] = transactions[i];
-        }
-        // Delete old array and update pointer/capacity
-        delete[] transactions;
-        transactions = new_transactions;
-        capacity = new_capacity;
+        reserve(new_capacity);
     }
     transactions[size] = t;
     size++;
+    invalidateIndexes();
+}
+
+// Adds a transaction to the array, moving its strings instead of copying them
+void ArrayStore::addTransaction(Transaction&& t) {
+    if (size >= capacity) {
+        int new_capacity = capacity * 2;
+        if (new_capacity == 0) new_capacity = 1;
+        reserve(new_capacity);
+    }
+    transactions[size] = std::move(t);
+    size++;
+    invalidateIndexes();
+}
+
+// Returns the transaction at the given position
+const Transaction& ArrayStore::at(int index) const {
+    return transactions[index];
 }
 
 // Returns the current number of transactions in the array
@@ -48,14 +141,7 @@ void ArrayStore::display() const {
     // Show first 10 transactions
     int displayCount = (size > 10) ? 10 : size;
     for (int i = 0; i < displayCount; ++i) {
-        const Transaction& t = transactions[i];
-        std::cout << "ID: " << t.transaction_id
-                  << ", Date: " << t.timestamp
-                  << ", Amount: " << t.amount
-                  << ", Type: " << t.transaction_type
-                  << ", Location: " << t.location
-                  << ", Channel: " << t.payment_channel
-                  << std::endl;
+        printTransaction(transactions[i]);
     }
     
     // If there are more transactions, ask user if they want to see all
@@ -70,14 +156,7 @@ void ArrayStore::display() const {
         if (choice == 'y' || choice == 'Y') {
             std::cout << "\n--- ALL TRANSACTIONS (Array) ---\n";
             for (int i = 0; i < size; ++i) {
-                const Transaction& t = transactions[i];
-                std::cout << "ID: " << t.transaction_id
-                          << ", Date: " << t.timestamp
-                          << ", Amount: " << t.amount
-                          << ", Type: " << t.transaction_type
-                          << ", Location: " << t.location
-                          << ", Channel: " << t.payment_channel
-                          << std::endl;
+                printTransaction(transactions[i]);
             }
             std::cout << "Total: " << size << " transactions\n";
         }
@@ -88,120 +167,380 @@ void ArrayStore::display() const {
     std::cout << "-------------------\n";
 }
 
-// Groups transactions by payment channel (returns a new ArrayStore)
-ArrayStore ArrayStore::groupByPaymentChannel(const std::string& channel) const {
-    ArrayStore grouped(capacity); // Create a new ArrayStore with the same capacity
+// Groups transactions by payment channel (returns a selection of this array)
+ArraySelection ArrayStore::groupByPaymentChannel(const std::string& channel) const {
+    // Compare dictionary codes instead of strings (an unknown channel matches nothing)
+    int code = dictionaryFor(COL_PAYMENT_CHANNEL).find(channel);
+    std::vector<int> rows;
     for (int i = 0; i < size; ++i) {
-        if (transactions[i].payment_channel == channel) {
-            grouped.addTransaction(transactions[i]);
+        if (transactions[i].payment_channel == code) {
+            rows.push_back(i);
         }
     }
-    return grouped;
-}
-
-// Helper function to merge two sorted halves
-void merge(Transaction* arr, int left, int mid, int right) {
-    int n1 = mid - left + 1;
-    int n2 = right - mid;
-    Transaction* L = new Transaction[n1];
-    Transaction* R = new Transaction[n2];
-    for (int i = 0; i < n1; ++i)
-        L[i] = arr[left + i];
-    for (int j = 0; j < n2; ++j)
-        R[j] = arr[mid + 1 + j];
-    int i = 0, j = 0, k = left;
-    while (i < n1 && j < n2) {
-        if (L[i].location <= R[j].location) {
-            arr[k] = L[i];
-            i++;
-        } else {
-            arr[k] = R[j];
-            j++;
+    return ArraySelection(*this, std::move(rows));
+}
+
+// Appends each row position to the group of its code (one pass, O(N) for any
+// number of distinct values)
+std::vector<ArraySelection> ArrayStore::partitionBy(int column) const {
+    std::vector<ArraySelection> groups;
+    if (columnType(column) != TYPE_CATEGORY) return groups;
+    int values = dictionaryFor(column).size();
+    std::vector<std::vector<int> > rows(values);
+    for (int i = 0; i < size; ++i) {
+        rows[transactions[i].categoryValue(column)].push_back(i);
+    }
+    groups.reserve(values);
+    for (int code = 0; code < values; ++code) {
+        groups.push_back(ArraySelection(*this, std::move(rows[code])));
+    }
+    return groups;
+}
+
+// Helper function to merge sort 64-bit keys (bottom-up, so there is no
+// recursion, and one scratch buffer is reused by every pass)
+static void mergeSortKeys(std::vector<uint64_t>& keys) {
+    size_t n = keys.size();
+    std::vector<uint64_t> scratch(n);
+    for (size_t width = 1; width < n; width *= 2) {
+        // merge adjacent runs [left, mid) and [mid, right) into scratch
+        for (size_t left = 0; left < n; left += 2 * width) {
+            size_t mid = std::min(left + width, n);
+            size_t right = std::min(left + 2 * width, n);
+            size_t i = left, j = mid, k = left;
+            while (i < mid && j < right) {
+                scratch[k++] = (keys[i] <= keys[j]) ? keys[i++] : keys[j++];
+            }
+            while (i < mid) scratch[k++] = keys[i++];
+            while (j < right) scratch[k++] = keys[j++];
         }
-        k++;
+        keys.swap(scratch);
     }
-    while (i < n1) {
-        arr[k] = L[i];
-        i++; k++;
+}
+
+// Returns row positions in location order (ties keep their original order)
+std::vector<int> ArrayStore::sortedOrderByLocation(SortStrategy strategy) const {
+    std::vector<int> rank = dictionaryFor(COL_LOCATION).sortedRanks();
+
+    if (strategy == SORT_COUNTING) {
+        // count the rows of each location, turn the counts into the first
+        // position of each location, then place every row in one scatter pass
+        std::vector<int> next(rank.size() + 1, 0);
+        for (int i = 0; i < size; ++i) {
+            next[rank[transactions[i].location] + 1]++;
+        }
+        for (size_t r = 1; r < next.size(); ++r) {
+            next[r] += next[r - 1];
+        }
+        std::vector<int> order(size);
+        for (int i = 0; i < size; ++i) {
+            order[next[rank[transactions[i].location]]++] = i;
+        }
+        return order;
     }
-    while (j < n2) {
-        arr[k] = R[j];
-        j++; k++;
+
+    // sort (location rank, row) keys; the row in the low bits keeps equal
+    // locations in their original order, so the sort is stable
+    std::vector<uint64_t> keys(size);
+    for (int i = 0; i < size; ++i) {
+        keys[i] = ((uint64_t)rank[transactions[i].location] << 32) | (uint32_t)i;
     }
-    delete[] L;
-    delete[] R;
+    mergeSortKeys(keys);
+
+    std::vector<int> order(size);
+    for (int i = 0; i < size; ++i) {
+        order[i] = (int)(uint32_t)keys[i];
+    }
+    return order;
 }
 
-// Recursive merge sort function
-void mergeSort(Transaction* arr, int left, int right) {
-    if (left < right) {
-        int mid = left + (right - left) / 2;
-        mergeSort(arr, left, mid);
-        mergeSort(arr, mid + 1, right);
-        merge(arr, left, mid, right);
+// Moves row order[i] to position i by following the permutation's cycles, so
+// each transaction is moved (not copied) once and no second array is needed
+void ArrayStore::applyOrder(std::vector<int> order) {
+    for (int start = 0; start < size; ++start) {
+        if (order[start] == start || order[start] < 0) continue;
+        Transaction saved = std::move(transactions[start]);
+        int current = start;
+        while (order[current] != start) {
+            int next = order[current];
+            transactions[current] = std::move(transactions[next]);
+            order[current] = -1; // placed
+            current = next;
+        }
+        transactions[current] = std::move(saved);
+        order[current] = -1;
     }
+    invalidateIndexes();
 }
 
 // Sorts transactions by location in ascending order
-void ArrayStore::sortByLocation() {
-    // Use merge sort to sort the transactions array by location
+void ArrayStore::sortByLocation(SortStrategy strategy) {
     if (size > 1) {
-        mergeSort(transactions, 0, size - 1);
+        applyOrder(sortedOrderByLocation(strategy));
     }
 }
 
-// Searches for transactions by type (returns a new ArrayStore)
-ArrayStore ArrayStore::searchByTransactionType(const std::string& type) const {
-    ArrayStore found(capacity); // Create a new ArrayStore with the same capacity
+// Sorts row numbers with a comparator that breaks ties on the row number, so
+// the parallel sort (which is not stable by itself) keeps equal rows in order
+std::vector<int> ArrayStore::parallelSortedOrder(int column, int numThreads) const {
+    std::vector<int> order(size);
     for (int i = 0; i < size; ++i) {
-        if (transactions[i].transaction_type == type) {
-            found.addTransaction(transactions[i]);
+        order[i] = i;
+    }
+    if (column < 0 || column >= COLUMN_COUNT) return order;
+
+    if (columnType(column) == TYPE_STRING) {
+        const Transaction* rows = transactions;
+        parallelMergeSort(order, numThreads, [rows, column](int a, int b) {
+            int c = rows[a].stringValue(column).compare(rows[b].stringValue(column));
+            return c < 0 || (c == 0 && a < b);
+        });
+        return order;
+    }
+
+    // every other column fits an order-preserving 64-bit key per row
+    std::vector<uint64_t> keys(size);
+    std::vector<int> rank;
+    if (columnType(column) == TYPE_CATEGORY) rank = dictionaryFor(column).sortedRanks();
+    for (int i = 0; i < size; ++i) {
+        const Transaction& t = transactions[i];
+        switch (columnType(column)) {
+            case TYPE_CATEGORY: keys[i] = rank[t.categoryValue(column)]; break;
+            case TYPE_TIMESTAMP: keys[i] = orderedIntKey(t.timestamp); break;
+            case TYPE_INT: keys[i] = orderedIntKey(t.velocity_score); break;
+            case TYPE_BOOL: keys[i] = t.is_fraud ? 1 : 0; break;
+            default: keys[i] = orderedDoubleKey(t.doubleValue(column)); break;
         }
     }
+    const uint64_t* k = keys.data();
+    parallelMergeSort(order, numThreads, [k](int a, int b) {
+        return k[a] < k[b] || (k[a] == k[b] && a < b);
+    });
+    return order;
+}
+
+// Sorts the row order in parallel and moves the rows into place once
+void ArrayStore::parallelSort(int column, int numThreads) {
+    if (size > 1) {
+        applyOrder(parallelSortedOrder(column, numThreads));
+    }
+}
+
+// Encodes every row's keys, then sorts the row numbers on them
+std::vector<int> ArrayStore::sortedOrderBy(const std::vector<SortKey>& keys) const {
+    SortKeyTable table(keys);
+    for (int i = 0; i < size; ++i) {
+        table.fitRow(transactions[i]);
+    }
+    table.allocate(size);
+    for (int i = 0; i < size; ++i) {
+        table.putRow(i, transactions[i]);
+    }
+    return table.sortedOrder();
+}
+
+// Sorts the row order on the keys and moves the rows into place once
+void ArrayStore::sortBy(const std::vector<SortKey>& keys) {
+    if (size > 1) {
+        applyOrder(sortedOrderBy(keys));
+    }
+}
+
+// Searches for transactions by type (returns a selection of this array)
+ArraySelection ArrayStore::searchByTransactionType(const std::string& type) const {
+    // Compare dictionary codes instead of strings (an unknown type matches nothing)
+    int code = dictionaryFor(COL_TRANSACTION_TYPE).find(type);
+    std::vector<int> rows;
+    for (int i = 0; i < size; ++i) {
+        if (transactions[i].transaction_type == code) {
+            rows.push_back(i);
+        }
+    }
+    return ArraySelection(*this, std::move(rows));
+}
+
+// Drops the time and account indexes so the next query rebuilds them
+void ArrayStore::invalidateIndexes() {
+    if (timeIndexValid) {
+        timeKeys.clear();
+        timeRows.clear();
+        timeIndexValid = false;
+    }
+    if (accountIndexValid) {
+        senderIndex.clear();
+        receiverIndex.clear();
+        accountIndexValid = false;
+    }
+}
+
+// Sorts (timestamp, position) pairs once; equal timestamps keep row order
+void ArrayStore::buildTimeIndex() const {
+    if (timeIndexValid) return;
+    std::vector<std::pair<int64_t, int> > entries(size);
+    for (int i = 0; i < size; ++i) {
+        entries[i] = std::make_pair(transactions[i].timestamp, i);
+    }
+    std::sort(entries.begin(), entries.end());
+
+    timeKeys.resize(size);
+    timeRows.resize(size);
+    for (int i = 0; i < size; ++i) {
+        timeKeys[i] = entries[i].first;
+        timeRows[i] = entries[i].second;
+    }
+    timeIndexValid = true;
+}
+
+// Finds the first timestamp >= from and the first timestamp > to
+void ArrayStore::timeRange(int64_t from, int64_t to, int& first, int& last) const {
+    buildTimeIndex();
+    first = (int)(std::lower_bound(timeKeys.begin(), timeKeys.end(), from) - timeKeys.begin());
+    // searching from first keeps last >= first even when to < from
+    last = (int)(std::upper_bound(timeKeys.begin() + first, timeKeys.end(), to) - timeKeys.begin());
+}
+
+// Copies the rows of one time range (returns a new ArrayStore)
+ArrayStore ArrayStore::rangeByTime(int64_t from, int64_t to) const {
+    int first, last;
+    timeRange(from, to, first, last);
+    ArrayStore found(last - first);
+    for (int i = first; i < last; ++i) {
+        found.addTransaction(transactions[timeRows[i]]);
+    }
     return found;
 }
 
+// Counts one time range from the index positions alone
+int ArrayStore::countByTime(int64_t from, int64_t to) const {
+    int first, last;
+    timeRange(from, to, first, last);
+    return last - first;
+}
+
+// Runs the query over the rows through a QuerySource on the array
+std::vector<int> ArrayStore::queryRows(const Query& query, const int* candidates, int count) const {
+    const Transaction* rows = transactions;
+    auto rowAt = [rows](int r) -> const Transaction& { return rows[r]; };
+    TransactionQuerySource<decltype(rowAt)> source(rowAt);
+    return query.matchingRows(source, candidates, count);
+}
+
+ArraySelection ArrayStore::where(const Query& query) const {
+    return ArraySelection(*this, queryRows(query, nullptr, size));
+}
+
+// Indexes both account columns by row position
+void ArrayStore::buildAccountIndexes() const {
+    if (accountIndexValid) return;
+    const Transaction* rows = transactions;
+    senderIndex.build(size, [rows](int i) -> const std::string& { return rows[i].sender_account; });
+    receiverIndex.build(size, [rows](int i) -> const std::string& { return rows[i].receiver_account; });
+    accountIndexValid = true;
+}
+
+// Copies the account's run of row positions out of the index
+static ArraySelection selectIndexed(const ArrayStore& store, const AccountIndex& index,
+                                    const std::string& account) {
+    int count;
+    const int* rows = index.find(account, count);
+    return ArraySelection(store, std::vector<int>(rows, rows + count));
+}
+
+ArraySelection ArrayStore::bySenderAccount(const std::string& account) const {
+    buildAccountIndexes();
+    return selectIndexed(*this, senderIndex, account);
+}
+
+ArraySelection ArrayStore::byReceiverAccount(const std::string& account) const {
+    buildAccountIndexes();
+    return selectIndexed(*this, receiverIndex, account);
+}
+
+size_t ArrayStore::accountIndexBytes() const {
+    return accountIndexValid ? senderIndex.byteSize() + receiverIndex.byteSize() : 0;
+}
+
 // Exports transactions to JSON format
 nlohmann::json ArrayStore::toJSON() const {
     nlohmann::json j_array = nlohmann::json::array(); // Create a JSON array
     for (int i = 0; i < size; ++i) {
-        const Transaction& t = transactions[i];
-        nlohmann::json j_trans = {
-            {"transaction_id", t.transaction_id},
-            {"timestamp", t.timestamp},
-            {"sender_account", t.sender_account},
-            {"receiver_account", t.receiver_account},
-            {"amount", t.amount},
-            {"transaction_type", t.transaction_type},
-            {"merchant_category", t.merchant_category},
-            {"location", t.location},
-            {"device_used", t.device_used},
-            {"is_fraud", t.is_fraud},
-            {"fraud_type", t.fraud_type},
-            {"time_since_last_transaction", t.time_since_last_transaction},
-            {"spending_deviation", t.spending_deviation},
-            {"velocity_score", t.velocity_score},
-            {"geo_anomaly", t.geo_anomaly},
-            {"payment_channel", t.payment_channel},
-            {"ip_address", t.ip_address},
-            {"device_hash", t.device_hash}
-        };
-        j_array.push_back(j_trans); // Add transaction to JSON array
+        j_array.push_back(transactionToJSON(transactions[i])); // Add transaction to JSON array
     }
     return j_array; // Return the JSON array
 }
 
-// Gets all fraudulent transactions
-ArrayStore ArrayStore::getFraudulentTransactions() const {
-    ArrayStore fraudulent(capacity); // Create a new ArrayStore with the same capacity
+// Streams transactions to a JSON file
+bool ArrayStore::exportJSON(const std::string& path, const JsonExportOptions& options) const {
+    TransactionJsonExporter exporter(options);
+    if (!exporter.open(path)) return false;
+    const Transaction* rows = transactions;
+    exporter.addRows(size, [rows](int i) -> const Transaction& { return rows[i]; }, options.threads);
+    return exporter.close();
+}
+
+// Writes transactions to a CSV file
+bool ArrayStore::exportCSV(const std::string& path, int numThreads) const {
+    TransactionCsvExporter exporter;
+    if (!exporter.open(path)) return false;
+    const Transaction* rows = transactions;
+    exporter.addRows(size, [rows](int i) -> const Transaction& { return rows[i]; }, numThreads);
+    return exporter.close();
+}
+
+// Builds the JSON object of one transaction
+nlohmann::json transactionToJSON(const Transaction& t) {
+    return nlohmann::json {
+        {"transaction_id", t.transaction_id},
+        {"timestamp", formatTimestamp(t.timestamp)},
+        {"sender_account", t.sender_account},
+        {"receiver_account", t.receiver_account},
+        {"amount", t.amount},
+        {"transaction_type", t.transactionTypeName()},
+        {"merchant_category", t.merchantCategoryName()},
+        {"location", t.locationName()},
+        {"device_used", t.deviceUsedName()},
+        {"is_fraud", t.is_fraud},
+        {"fraud_type", t.fraud_type},
+        {"time_since_last_transaction", t.time_since_last_transaction},
+        {"spending_deviation", t.spending_deviation},
+        {"velocity_score", t.velocity_score},
+        {"geo_anomaly", t.geo_anomaly},
+        {"payment_channel", t.paymentChannelName()},
+        {"ip_address", t.ip_address},
+        {"device_hash", t.device_hash}
+    };
+}
+
+// Prints the one-line summary used by display()
+void printTransaction(const Transaction& t) {
+    std::cout << "ID: " << t.transaction_id
+              << ", Date: " << formatTimestamp(t.timestamp)
+              << ", Amount: " << t.amount
+              << ", Type: " << t.transactionTypeName()
+              << ", Location: " << t.locationName()
+              << ", Channel: " << t.paymentChannelName()
+              << std::endl;
+}
+
+// Gets all fraudulent transactions (returns a selection of this array)
+ArraySelection ArrayStore::getFraudulentTransactions() const {
+    std::vector<int> rows;
     for (int i = 0; i < size; ++i) {
-        std::string fraudValue = transactions[i].is_fraud;
-        // Check for TRUE/FALSE values (case-insensitive)
-        if (toLower(fraudValue) == "true") {
-            fraudulent.addTransaction(transactions[i]);
+        // is_fraud is parsed to a bool at load time
+        if (transactions[i].is_fraud) {
+            rows.push_back(i);
         }
     }
-    return fraudulent;
+    return ArraySelection(*this, std::move(rows));
+}
+
+// Selection of every row, in array order
+ArraySelection ArrayStore::selectAll() const {
+    std::vector<int> rows(size);
+    for (int i = 0; i < size; ++i) {
+        rows[i] = i;
+    }
+    return ArraySelection(*this, std::move(rows));
 }
 
 // Debug method to check fraud values
@@ -210,30 +549,20 @@ void ArrayStore::debugFraudValues() const {
     std::cout << "Checking first 20 transactions:\n";
     for (int i = 0; i < std::min(20, size); ++i) {
         std::cout << "Transaction " << i << " ID: " << transactions[i].transaction_id 
-                  << " | is_fraud: '" << transactions[i].is_fraud << "'\n";
+                  << " | is_fraud: " << (transactions[i].is_fraud ? "true" : "false") << "\n";
     }
     
-    // Count different fraud values
-    std::map<std::string, int> fraudCounts;
+    // Count TRUE/FALSE values (parsed case-insensitively at load time)
     int trueCount = 0;
     int falseCount = 0;
     
     for (int i = 0; i < size; ++i) {
-        std::string fraudValue = transactions[i].is_fraud;
-        fraudCounts[fraudValue]++;
-        
-        // Count TRUE/FALSE specifically
-        if (toLower(fraudValue) == "true") trueCount++;
-        if (toLower(fraudValue) == "false") falseCount++;
+        if (transactions[i].is_fraud) trueCount++;
+        else falseCount++;
     }
     
     std::cout << "\nFraud value distribution across all " << size << " transactions:\n";
-    for (const auto& pair : fraudCounts) {
-        std::cout << "Value '" << pair.first << "': " << pair.second << " transactions\n";
-    }
-    
-    std::cout << "\nCase-insensitive counts:\n";
     std::cout << "TRUE values: " << trueCount << "\n";
     std::cout << "FALSE values: " << falseCount << "\n";
     std::cout << "Total: " << (trueCount + falseCount) << " (should equal " << size << ")\n";
-} 
\ No newline at end of file
+}
\ No newline at end of file
@@ -2,8 +2,16 @@
 #define ARRAY_STORE_HPP
 
 #include <string>
+#include <vector>
+#include <cstdint>
 #include "../lib/json.hpp" // For JSON export
+#include "json_writer.hpp"
+#include "csv_writer.hpp"
 #include "transaction.hpp" // Use shared Transaction struct and utilities
+#include "sort_key.hpp"
+#include "array_selection.hpp"
+#include "account_index.hpp"
+#include "query.hpp"
 
 // Array-based class to store and manage transactions
 class ArrayStore {
@@ -12,37 +20,151 @@ private:
     int capacity;              // Maximum number of transactions
     int size;                  // Current number of transactions
 
+    // Time index: row positions ordered by timestamp, with the timestamps copied
+    // alongside so binary search stays in one contiguous array. Built on first
+    // use and dropped whenever rows are added or reordered.
+    mutable std::vector<int64_t> timeKeys;
+    mutable std::vector<int> timeRows;
+    mutable bool timeIndexValid;
+
+    // Account indexes: rows of each sender_account and receiver_account.
+    // Built by buildAccountIndexes() or the first lookup, dropped with the
+    // time index.
+    mutable AccountIndex senderIndex;
+    mutable AccountIndex receiverIndex;
+    mutable bool accountIndexValid;
+
+    // Forget the time and account indexes after the rows change
+    void invalidateIndexes();
+
+    // Positions [first, last) in the time index of timestamps within [from, to]
+    void timeRange(int64_t from, int64_t to, int& first, int& last) const;
+
+    // Rearrange the rows so that row order[i] moves to position i
+    void applyOrder(std::vector<int> order);
+
 public:
     // Constructor and destructor
     ArrayStore(int max_size = 1000);
     ~ArrayStore();
 
+    // Copy constructor and assignment operator (deep copy)
+    ArrayStore(const ArrayStore& other);
+    ArrayStore& operator=(const ArrayStore& other);
+
+    // Move constructor and assignment operator (take over the array)
+    ArrayStore(ArrayStore&& other);
+    ArrayStore& operator=(ArrayStore&& other);
+
     // Add a transaction to the array
     void addTransaction(const Transaction& t);
+    void addTransaction(Transaction&& t);
+
+    // Grow the capacity to at least min_capacity without changing the contents
+    void reserve(int min_capacity);
+
+    // Access a transaction by position
+    const Transaction& at(int index) const;
+
+    // Group transactions by payment channel. Filters return a selection (this
+    // array plus the positions of the matching rows) instead of copying rows;
+    // call materialize() on it for an independent ArrayStore.
+    ArraySelection groupByPaymentChannel(const std::string& channel) const;
+
+    // Sort transactions by location (ascending, stable). Row positions are
+    // sorted on their location codes and the rows are moved into place once.
+    void sortByLocation(SortStrategy strategy = SORT_MERGE);
+
+    // Row positions in location order without moving any rows (a sorted view:
+    // at(order[0]), at(order[1]), ... visits the rows sorted by location)
+    std::vector<int> sortedOrderByLocation(SortStrategy strategy = SORT_MERGE) const;
+
+    // Sort transactions by any column (ascending, stable) with numThreads
+    // threads (0 = one per core): runs are merge sorted in parallel and then
+    // combined by a parallel multiway merge. Sorting on COL_LOCATION gives
+    // exactly the same order as sortByLocation.
+    void parallelSort(int column, int numThreads = 0);
+
+    // Row positions in column order, without moving any rows
+    std::vector<int> parallelSortedOrder(int column, int numThreads = 0) const;
 
-    // Group transactions by payment channel (returns a new ArrayStore)
-    ArrayStore groupByPaymentChannel(const std::string& channel) const;
+    // Sort by several columns, each ascending or descending (stable), e.g.
+    // {{COL_SENDER_ACCOUNT, false}, {COL_TIMESTAMP, false}}
+    void sortBy(const std::vector<SortKey>& keys);
 
-    // Sort transactions by location (ascending)
-    void sortByLocation();
+    // Row positions in sortBy order, without moving any rows
+    std::vector<int> sortedOrderBy(const std::vector<SortKey>& keys) const;
 
-    // Search for transactions by type (returns a new ArrayStore)
-    ArrayStore searchByTransactionType(const std::string& type) const;
+    // Split the rows by a categorical column in one scan: group c holds the
+    // rows whose code is c (dictionaryFor(column).lookup(c) is its value), so
+    // every distinct value gets its group and count at once. Returns no groups
+    // for a column that is not TYPE_CATEGORY.
+    std::vector<ArraySelection> partitionBy(int column) const;
+
+    // Search for transactions by type (returns a selection)
+    ArraySelection searchByTransactionType(const std::string& type) const;
+
+    // Build the time index now (otherwise it is built by the first time query)
+    void buildTimeIndex() const;
+
+    // Transactions with from <= timestamp <= to (epoch microseconds), in time
+    // order (returns a new ArrayStore; binary search on the time index)
+    ArrayStore rangeByTime(int64_t from, int64_t to) const;
+
+    // Number of transactions with from <= timestamp <= to, without copying them
+    int countByTime(int64_t from, int64_t to) const;
+
+    // Transactions matching every predicate of query (returns a selection)
+    ArraySelection where(const Query& query) const;
+
+    // Positions among candidates[0 .. count) that match query (candidates =
+    // nullptr tests every row); used by where() here and in ArraySelection
+    std::vector<int> queryRows(const Query& query, const int* candidates, int count) const;
+
+    // Build the sender and receiver account indexes now (otherwise they are
+    // built by the first account lookup)
+    void buildAccountIndexes() const;
+
+    // Transactions sent or received by account, in array order (returns a
+    // selection; O(k) for k matches once the indexes are built)
+    ArraySelection bySenderAccount(const std::string& account) const;
+    ArraySelection byReceiverAccount(const std::string& account) const;
+
+    // Estimated memory held by the account indexes (0 when not built)
+    size_t accountIndexBytes() const;
 
     // Export transactions to JSON
     nlohmann::json toJSON() const;
 
+    // Stream the transactions to a JSON file without building the JSON tree
+    // (by default the same text as toJSON().dump(4); options pick a compact or
+    // NDJSON layout and a subset of the fields). Returns false if the file
+    // cannot be written
+    bool exportJSON(const std::string& path, const JsonExportOptions& options = JsonExportOptions()) const;
+
+    // Write the transactions to a CSV file in the dataset's layout (it loads
+    // back unchanged), formatted on numThreads threads (0 = one per core).
+    // Returns false if the file cannot be written
+    bool exportCSV(const std::string& path, int numThreads = 0) const;
+
     // Display transactions to console
     void display() const;
 
     // Get the number of transactions
     int getSize() const;
 
-    // Get fraudulent transactions
-    ArrayStore getFraudulentTransactions() const;
+    // Get fraudulent transactions (returns a selection)
+    ArraySelection getFraudulentTransactions() const;
+
+    // Selection of every row, the starting point for chained filters
+    ArraySelection selectAll() const;
 
     // Debug method to check fraud values
     void debugFraudValues() const;
 };
 
+// Row formatting shared by ArrayStore and ArraySelection
+nlohmann::json transactionToJSON(const Transaction& t);
+void printTransaction(const Transaction& t);
+
 #endif // ARRAY_STORE_HPP 
\ No newline at end of file
@@ -0,0 +1,37 @@
+#ifndef BIT_OPS_HPP
+#define BIT_OPS_HPP
+
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// Bit scans on 64-bit masks, with the GCC/Clang builtins or their MSVC
+// equivalents
+
+// Index of the lowest set bit (mask must be non-zero)
+static inline int lowestBit(uint64_t mask) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward64(&index, mask);
+    return (int)index;
+#else
+    return __builtin_ctzll(mask);
+#endif
+}
+
+// Number of set bits
+static inline int bitCount(uint64_t mask) {
+#if defined(_MSC_VER)
+    // bit-slicing count: no dependence on the POPCNT instruction
+    mask = mask - ((mask >> 1) & 0x5555555555555555ULL);
+    mask = (mask & 0x3333333333333333ULL) + ((mask >> 2) & 0x3333333333333333ULL);
+    mask = (mask + (mask >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return (int)((mask * 0x0101010101010101ULL) >> 56);
+#else
+    return __builtin_popcountll(mask);
+#endif
+}
+
+#endif // BIT_OPS_HPP
@@ -0,0 +1,156 @@
+#include "bitmap_index.hpp"
+#include "bit_ops.hpp"
+#include <utility>
+
+static const size_t WORD_BITS = 64;
+
+// Constructor: enough words for size bits, all zero
+Bitmap::Bitmap(size_t size) : words((size + WORD_BITS - 1) / WORD_BITS, 0), bits(size) {}
+
+void Bitmap::set(size_t row) {
+    words[row / WORD_BITS] |= (uint64_t)1 << (row % WORD_BITS);
+}
+
+bool Bitmap::test(size_t row) const {
+    return (words[row / WORD_BITS] >> (row % WORD_BITS)) & 1;
+}
+
+size_t Bitmap::size() const {
+    return bits;
+}
+
+// Population count of every word
+size_t Bitmap::count() const {
+    size_t total = 0;
+    for (size_t w = 0; w < words.size(); ++w) {
+        total += (size_t)bitCount(words[w]);
+    }
+    return total;
+}
+
+void Bitmap::clearTail() {
+    if (bits % WORD_BITS != 0) {
+        words.back() &= ((uint64_t)1 << (bits % WORD_BITS)) - 1;
+    }
+}
+
+// The loops below are plain word loops so the compiler can vectorize them
+Bitmap& Bitmap::operator&=(const Bitmap& other) {
+    uint64_t* a = words.data();
+    const uint64_t* b = other.words.data();
+    for (size_t w = 0, n = words.size(); w < n; ++w) {
+        a[w] &= b[w];
+    }
+    return *this;
+}
+
+Bitmap& Bitmap::operator|=(const Bitmap& other) {
+    uint64_t* a = words.data();
+    const uint64_t* b = other.words.data();
+    for (size_t w = 0, n = words.size(); w < n; ++w) {
+        a[w] |= b[w];
+    }
+    return *this;
+}
+
+Bitmap& Bitmap::andNot(const Bitmap& other) {
+    uint64_t* a = words.data();
+    const uint64_t* b = other.words.data();
+    for (size_t w = 0, n = words.size(); w < n; ++w) {
+        a[w] &= ~b[w];
+    }
+    return *this;
+}
+
+// Complement within size() rows
+Bitmap Bitmap::operator~() const {
+    Bitmap result(bits);
+    for (size_t w = 0; w < words.size(); ++w) {
+        result.words[w] = ~words[w];
+    }
+    result.clearTail();
+    return result;
+}
+
+Bitmap operator&(Bitmap left, const Bitmap& right) {
+    left &= right;
+    return left;
+}
+
+Bitmap operator|(Bitmap left, const Bitmap& right) {
+    left |= right;
+    return left;
+}
+
+// Visits only the set bits: take the lowest set bit, then clear it
+std::vector<int> Bitmap::toRows() const {
+    std::vector<int> rows;
+    rows.reserve(count());
+    for (size_t w = 0; w < words.size(); ++w) {
+        uint64_t word = words[w];
+        while (word != 0) {
+            rows.push_back((int)(w * WORD_BITS + (size_t)lowestBit(word)));
+            word &= word - 1;
+        }
+    }
+    return rows;
+}
+
+size_t Bitmap::byteSize() const {
+    return words.size() * sizeof(uint64_t);
+}
+
+// Columns that get one bitmap per dictionary code
+static const int INDEXED_COLUMNS[] = {
+    COL_TRANSACTION_TYPE, COL_MERCHANT_CATEGORY, COL_LOCATION, COL_DEVICE_USED, COL_PAYMENT_CHANNEL
+};
+
+// Constructor: sizes a bitmap for every code, then sets each row's bits
+BitmapIndex::BitmapIndex(const ArrayStore& source)
+    : store(&source), values(COLUMN_COUNT), fraudRows(source.getSize()), noRows(source.getSize()) {
+    size_t rows = source.getSize();
+    for (int col : INDEXED_COLUMNS) {
+        values[col].assign(dictionaryFor(col).size(), Bitmap(rows));
+    }
+    for (size_t i = 0; i < rows; ++i) {
+        const Transaction& t = source.at((int)i);
+        for (int col : INDEXED_COLUMNS) {
+            values[col][t.categoryValue(col)].set(i);
+        }
+        if (t.is_fraud) fraudRows.set(i);
+    }
+}
+
+// An unknown value (or an unindexed column) matches no rows
+const Bitmap& BitmapIndex::equals(int column, const std::string& value) const {
+    int code = (column >= 0 && column < COLUMN_COUNT) ? dictionaryFor(column).find(value) : -1;
+    if (code < 0) return noRows;
+    return equals(column, (CategoryCode)code);
+}
+
+const Bitmap& BitmapIndex::equals(int column, CategoryCode code) const {
+    if (column < 0 || column >= COLUMN_COUNT || code >= values[column].size()) return noRows;
+    return values[column][code];
+}
+
+const Bitmap& BitmapIndex::fraud() const {
+    return fraudRows;
+}
+
+Bitmap BitmapIndex::all() const {
+    return ~noRows;
+}
+
+ArraySelection BitmapIndex::select(const Bitmap& rows) const {
+    return ArraySelection(*store, rows.toRows());
+}
+
+size_t BitmapIndex::byteSize() const {
+    size_t total = fraudRows.byteSize() + noRows.byteSize();
+    for (size_t col = 0; col < values.size(); ++col) {
+        for (size_t code = 0; code < values[col].size(); ++code) {
+            total += values[col][code].byteSize();
+        }
+    }
+    return total;
+}
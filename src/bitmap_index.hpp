@@ -0,0 +1,85 @@
+#ifndef BITMAP_INDEX_HPP
+#define BITMAP_INDEX_HPP
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "transaction.hpp"
+#include "array_store.hpp"
+
+// One bit per row, packed into 64-bit words (bit i of word w is row 64*w + i).
+// Bits past the last row are always zero, so count() and the word-wise
+// operators never see rows that do not exist. Both operands of a binary
+// operator must describe the same rows (same size()).
+class Bitmap {
+private:
+    std::vector<uint64_t> words;
+    size_t bits; // Number of rows
+
+    // Zero the unused bits of the last word
+    void clearTail();
+
+public:
+    // Constructor: size rows, all clear
+    explicit Bitmap(size_t size = 0);
+
+    void set(size_t row);
+    bool test(size_t row) const;
+
+    // Number of rows (set or not) and number of set rows
+    size_t size() const;
+    size_t count() const;
+
+    // Word-wise composition
+    Bitmap& operator&=(const Bitmap& other);
+    Bitmap& operator|=(const Bitmap& other);
+    Bitmap& andNot(const Bitmap& other); // this AND NOT other, without a temporary
+    Bitmap operator~() const;
+
+    // Positions of the set rows in increasing order
+    std::vector<int> toRows() const;
+
+    // Memory held by the words
+    size_t byteSize() const;
+};
+
+Bitmap operator&(Bitmap left, const Bitmap& right);
+Bitmap operator|(Bitmap left, const Bitmap& right);
+
+// Bitmap per distinct value of the low-cardinality columns of an ArrayStore:
+// transaction_type, merchant_category, location, device_used, payment_channel
+// (one per dictionary code) and is_fraud. A compound filter such as
+//     index.equals(COL_TRANSACTION_TYPE, "withdrawal") & index.equals(COL_PAYMENT_CHANNEL, "card")
+//         & index.fraud() & index.equals(COL_LOCATION, "Tokyo")
+// is a few word-wise ANDs, and select() turns the result into rows. The index
+// is a snapshot: rebuild it after the store is added to or sorted.
+class BitmapIndex {
+private:
+    const ArrayStore* store;
+    std::vector<std::vector<Bitmap> > values; // [column][code], empty for unindexed columns
+    Bitmap fraudRows;
+    Bitmap noRows; // Returned for values that never occur
+
+public:
+    // Constructor: builds every bitmap in one pass over the store
+    explicit BitmapIndex(const ArrayStore& source);
+
+    // Rows whose column equals value (column must be categorical)
+    const Bitmap& equals(int column, const std::string& value) const;
+    const Bitmap& equals(int column, CategoryCode code) const;
+
+    // Rows with is_fraud set (~fraud() for legitimate rows)
+    const Bitmap& fraud() const;
+
+    // Every row (the identity for AND)
+    Bitmap all() const;
+
+    // Rows of a bitmap as a selection of the indexed store
+    ArraySelection select(const Bitmap& rows) const;
+
+    // Memory held by all bitmaps
+    size_t byteSize() const;
+};
+
+#endif // BITMAP_INDEX_HPP
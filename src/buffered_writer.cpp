@@ -0,0 +1,210 @@
+#include "buffered_writer.hpp"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <stdexcept>
+#include <cstring>
+
+#ifdef _WIN32
+#include <io.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+// Constructor: allocates the buffer once
+BufferedWriter::BufferedWriter(size_t bufferSize) : buffer(bufferSize) {
+    fd = -1;
+    used = 0;
+    failed = false;
+    written = 0;
+}
+
+BufferedWriter::~BufferedWriter() {
+    close();
+}
+
+bool BufferedWriter::open(const std::string& path) {
+    close();
+#ifdef _WIN32
+    fd = ::_open(path.c_str(), _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY, _S_IREAD | _S_IWRITE);
+#else
+    fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+#endif
+    used = 0;
+    failed = false;
+    written = 0;
+    return fd >= 0;
+}
+
+// write() may accept fewer bytes than asked; loop until the buffer is out
+void BufferedWriter::flush() {
+    if (fd < 0) {
+        buffer.resize(std::max(buffer.size() * 2, (size_t)4096));
+        return;
+    }
+    size_t done = 0;
+    while (done < used && !failed) {
+#ifdef _WIN32
+        int n = ::_write(fd, buffer.data() + done, (unsigned)(used - done));
+#else
+        ssize_t n = ::write(fd, buffer.data() + done, used - done);
+#endif
+        if (n <= 0) {
+            failed = true;
+        } else {
+            done += (size_t)n;
+        }
+    }
+    used = 0;
+}
+
+bool BufferedWriter::close() {
+    if (fd < 0) return !failed;
+    flush();
+#ifdef _WIN32
+    if (::_close(fd) != 0) failed = true;
+#else
+    if (::close(fd) != 0) failed = true;
+#endif
+    fd = -1;
+    return !failed;
+}
+
+// Copies into the buffer, flushing as often as needed
+void BufferedWriter::raw(const char* data, size_t length) {
+    written += length;
+    while (length > 0) {
+        if (used == buffer.size()) flush();
+        size_t n = std::min(length, buffer.size() - used);
+        std::memcpy(buffer.data() + used, data, n);
+        used += n;
+        data += n;
+        length -= n;
+    }
+}
+
+// Digits are produced backwards into a small buffer
+void BufferedWriter::integer(int64_t value) {
+    char text[24];
+    char* end = text + sizeof(text);
+    char* p = end;
+    uint64_t magnitude = value < 0 ? 0 - (uint64_t)value : (uint64_t)value;
+    do {
+        *--p = (char)('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude != 0);
+    if (value < 0) *--p = '-';
+    raw(p, (size_t)(end - p));
+}
+
+uint64_t BufferedWriter::bytesWritten() const {
+    return written;
+}
+
+void BufferedWriter::discard() {
+    used = 0;
+    written = 0;
+}
+
+void writeInOrder(BufferedWriter& out, int count, int numThreads,
+                  const std::function<void(BufferedWriter&, int, int)>& format) {
+    if (numThreads <= 0) {
+        numThreads = (int)std::thread::hardware_concurrency();
+    }
+    if (numThreads <= 1 || count <= EXPORT_CHUNK_ROWS) {
+        if (count > 0) format(out, 0, count); // no copy through chunk buffers
+        return;
+    }
+    formatInOrder(count, numThreads, 1, [&format](BufferedWriter* const* to, int begin, int end) {
+        format(*to[0], begin, end);
+    }, [&out](BufferedWriter* const* from) {
+        out.raw(from[0]->bufferedData(), from[0]->bufferedSize());
+    });
+}
+
+// Slot c % window holds the writers of chunk c. A worker reuses a slot only
+// after the chunk before it in that slot has been emitted, and the calling
+// thread emits chunk c only once its slot is marked ready for c.
+void formatInOrder(int count, int numThreads, int outputs,
+                   const std::function<void(BufferedWriter* const*, int, int)>& format,
+                   const std::function<void(BufferedWriter* const*)>& emit) {
+    if (outputs <= 0) {
+        throw std::invalid_argument("formatInOrder: outputs must be positive");
+    }
+    if (numThreads <= 0) {
+        numThreads = (int)std::thread::hardware_concurrency();
+        if (numThreads <= 0) numThreads = 1;
+    }
+    int chunks = (count + EXPORT_CHUNK_ROWS - 1) / EXPORT_CHUNK_ROWS;
+    if (numThreads > chunks) numThreads = chunks;
+
+    int window = numThreads > 1 ? 2 * numThreads : 1;
+    std::vector<std::unique_ptr<BufferedWriter> > writers(window * outputs);
+    std::vector<BufferedWriter*> slots(window * outputs); // outputs writers per slot
+    for (size_t w = 0; w < writers.size(); ++w) {
+        writers[w].reset(new BufferedWriter(1 << 16));
+        slots[w] = writers[w].get();
+    }
+    auto formatChunk = [&](int c) {
+        BufferedWriter* const* to = &slots[(c % window) * outputs];
+        for (int k = 0; k < outputs; ++k) {
+            to[k]->discard();
+        }
+        int begin = c * EXPORT_CHUNK_ROWS;
+        format(to, begin, std::min(count, begin + EXPORT_CHUNK_ROWS));
+    };
+    if (numThreads <= 1) {
+        for (int c = 0; c < chunks; ++c) {
+            formatChunk(c);
+            emit(&slots[0]);
+        }
+        return;
+    }
+
+    std::vector<int> ready(window, -1); // Chunk whose text each slot holds
+    int chunksEmitted = 0;
+    std::atomic<int> nextChunk(0);
+    std::mutex lock;
+    std::condition_variable changed;
+
+    auto work = [&]() {
+        for (int c = nextChunk++; c < chunks; c = nextChunk++) {
+            {
+                std::unique_lock<std::mutex> guard(lock);
+                changed.wait(guard, [&] { return chunksEmitted > c - window; });
+            }
+            formatChunk(c);
+            {
+                std::lock_guard<std::mutex> guard(lock);
+                ready[c % window] = c;
+            }
+            changed.notify_all();
+        }
+    };
+    std::vector<std::thread> workers;
+    for (int t = 0; t < numThreads; ++t) {
+        workers.push_back(std::thread(work));
+    }
+
+    for (int c = 0; c < chunks; ++c) {
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            changed.wait(guard, [&] { return ready[c % window] == c; });
+        }
+        emit(&slots[(c % window) * outputs]);
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            chunksEmitted = c + 1;
+        }
+        changed.notify_all();
+    }
+    for (size_t t = 0; t < workers.size(); ++t) {
+        workers[t].join();
+    }
+}
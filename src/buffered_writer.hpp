@@ -0,0 +1,79 @@
+#ifndef BUFFERED_WRITER_HPP
+#define BUFFERED_WRITER_HPP
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+
+// Buffered output to a file descriptor, used by the JSON and CSV exporters.
+// Text is collected in a fixed buffer and handed to write() when it fills, so
+// memory stays constant however much is written. A writer that has not been
+// opened keeps everything in memory instead (the buffer grows), which is how
+// worker threads format their part of a parallel export.
+class BufferedWriter {
+private:
+    int fd;                   // -1 when not open
+    std::vector<char> buffer;
+    size_t used;              // Bytes waiting in buffer
+    bool failed;              // A write() failed; close() reports it
+    uint64_t written;         // Bytes passed to the writer so far
+
+    // Write out the buffered bytes (or grow the buffer when not open)
+    void flush();
+
+public:
+    // Constructor: bufferSize bytes are collected per write() call
+    explicit BufferedWriter(size_t bufferSize = 1 << 20);
+    ~BufferedWriter();
+
+    // Not copyable (it owns the file descriptor)
+    BufferedWriter(const BufferedWriter&) = delete;
+    BufferedWriter& operator=(const BufferedWriter&) = delete;
+
+    // Create or truncate path for writing; returns false if it cannot be opened
+    bool open(const std::string& path);
+
+    // Flush and close; returns false if any write failed
+    bool close();
+
+    // Unformatted text
+    void raw(const char* data, size_t length);
+    void raw(const std::string& text) { raw(text.data(), text.size()); }
+
+    // Decimal integer
+    void integer(int64_t value);
+
+    // Bytes written so far (including those still buffered)
+    uint64_t bytesWritten() const;
+
+    // Text held in memory by a writer that is not open, and a way to reuse it
+    const char* bufferedData() const { return buffer.data(); }
+    size_t bufferedSize() const { return used; }
+    void discard();
+};
+
+// Rows per chunk of a parallel export (about 1.3 MB of pretty JSON)
+const int EXPORT_CHUNK_ROWS = 2048;
+
+// Writes the text of rows [0, count) to out in row order, formatted on
+// numThreads threads (0 = one per core). format(to, begin, end) appends the
+// text of rows [begin, end) to to; it runs concurrently on different chunks,
+// so it must only read shared data. Workers take EXPORT_CHUNK_ROWS-row chunks
+// in turn and format each into its own in-memory writer; the calling thread
+// writes finished chunks in order. At most two chunks per thread are held at
+// a time, so memory stays bounded, and the file is the same as with one thread.
+void writeInOrder(BufferedWriter& out, int count, int numThreads,
+                  const std::function<void(BufferedWriter&, int, int)>& format);
+
+// The same pipeline with several outputs per chunk: format(to, begin, end)
+// fills the in-memory writers to[0] .. to[outputs - 1] for rows [begin, end),
+// then emit(from) is called on the calling thread with those writers, one
+// chunk at a time in row order. With one thread the chunks are formatted on
+// the calling thread. Throws std::invalid_argument if outputs is not positive.
+void formatInOrder(int count, int numThreads, int outputs,
+                   const std::function<void(BufferedWriter* const*, int, int)>& format,
+                   const std::function<void(BufferedWriter* const*)>& emit);
+
+#endif // BUFFERED_WRITER_HPP
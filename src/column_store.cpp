@@ -0,0 +1,681 @@
+#include "column_store.hpp"
+#include "timestamp.hpp"
+#include <iostream>
+#include <fstream>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+// Constructor: starts with the leading zero offset
+StringColumn::StringColumn() {
+    offsets.push_back(0);
+}
+
+// Appends a value to the end of the buffer
+void StringColumn::push_back(const char* data, size_t length) {
+    bytes.append(data, length);
+    offsets.push_back(bytes.size());
+}
+
+void StringColumn::push_back(const std::string& value) {
+    push_back(value.data(), value.size());
+}
+
+// Returns the bytes of value i
+StringRef StringColumn::get(size_t i) const {
+    StringRef ref = { bytes.data() + offsets[i], (size_t)(offsets[i + 1] - offsets[i]) };
+    return ref;
+}
+
+// Returns the number of values
+size_t StringColumn::size() const {
+    return offsets.size() - 1;
+}
+
+// Preallocates the offset and byte buffers
+void StringColumn::reserve(size_t rows, size_t byteCount) {
+    offsets.reserve(rows + 1);
+    bytes.reserve(byteCount);
+}
+
+// Uses rows values held elsewhere (offsetData has rows + 1 entries)
+void StringColumn::borrow(const char* byteData, size_t byteCount, const uint64_t* offsetData, size_t rows) {
+    bytes.borrow(byteData, byteCount);
+    offsets.borrow(offsetData, rows + 1);
+}
+
+// Copies the selected values of a fixed-width column
+template <typename T>
+static void gather(const FixedColumn<T>& source, const std::vector<int>& rows, FixedColumn<T>& target) {
+    const T* values = source.data();
+    target.reserve(rows.size());
+    for (size_t i = 0; i < rows.size(); ++i) {
+        target.push_back(values[rows[i]]);
+    }
+}
+
+// Copies the selected values of a string column
+static void gather(const StringColumn& source, const std::vector<int>& rows, StringColumn& target) {
+    for (size_t i = 0; i < rows.size(); ++i) {
+        StringRef value = source.get(rows[i]);
+        target.push_back(value.data, value.size);
+    }
+}
+
+// Constructor: reserves room for max_size rows in every column
+ColumnStore::ColumnStore(int max_size) {
+    size = 0;
+    size_t rows = max_size > 0 ? max_size : 0;
+    timestamp.reserve(rows);
+    amount.reserve(rows);
+    transaction_type.reserve(rows);
+    merchant_category.reserve(rows);
+    location.reserve(rows);
+    device_used.reserve(rows);
+    payment_channel.reserve(rows);
+    is_fraud.reserve(rows);
+    time_since_last_transaction.reserve(rows);
+    spending_deviation.reserve(rows);
+    velocity_score.reserve(rows);
+    geo_anomaly.reserve(rows);
+}
+
+// Appends every field of t to its column
+void ColumnStore::addTransaction(const Transaction& t) {
+    transaction_id.push_back(t.transaction_id);
+    timestamp.push_back(t.timestamp);
+    sender_account.push_back(t.sender_account);
+    receiver_account.push_back(t.receiver_account);
+    amount.push_back(t.amount);
+    transaction_type.push_back(t.transaction_type);
+    merchant_category.push_back(t.merchant_category);
+    location.push_back(t.location);
+    device_used.push_back(t.device_used);
+    is_fraud.push_back(t.is_fraud ? 1 : 0);
+    fraud_type.push_back(t.fraud_type);
+    time_since_last_transaction.push_back(t.time_since_last_transaction);
+    spending_deviation.push_back(t.spending_deviation);
+    velocity_score.push_back(t.velocity_score);
+    geo_anomaly.push_back(t.geo_anomaly);
+    payment_channel.push_back(t.payment_channel);
+    ip_address.push_back(t.ip_address);
+    device_hash.push_back(t.device_hash);
+    size++;
+}
+
+// Reassembles one row from the columns
+Transaction ColumnStore::getTransaction(int index) const {
+    Transaction t;
+    t.transaction_id = transaction_id.get(index).str();
+    t.timestamp = timestamp[index];
+    t.sender_account = sender_account.get(index).str();
+    t.receiver_account = receiver_account.get(index).str();
+    t.amount = amount[index];
+    t.transaction_type = transaction_type[index];
+    t.merchant_category = merchant_category[index];
+    t.location = location[index];
+    t.device_used = device_used[index];
+    t.is_fraud = is_fraud[index] != 0;
+    t.fraud_type = fraud_type.get(index).str();
+    t.time_since_last_transaction = time_since_last_transaction[index];
+    t.spending_deviation = spending_deviation[index];
+    t.velocity_score = velocity_score[index];
+    t.geo_anomaly = geo_anomaly[index];
+    t.payment_channel = payment_channel[index];
+    t.ip_address = ip_address.get(index).str();
+    t.device_hash = device_hash.get(index).str();
+    return t;
+}
+
+// Returns the current number of rows
+int ColumnStore::getSize() const {
+    return size;
+}
+
+// Columns by TransactionColumn (col must have the matching columnType)
+const StringColumn* ColumnStore::stringColumnFor(int col) const {
+    switch (col) {
+        case COL_TRANSACTION_ID: return &transaction_id;
+        case COL_SENDER_ACCOUNT: return &sender_account;
+        case COL_RECEIVER_ACCOUNT: return &receiver_account;
+        case COL_FRAUD_TYPE: return &fraud_type;
+        case COL_IP_ADDRESS: return &ip_address;
+        default: return &device_hash;
+    }
+}
+
+const FixedColumn<CategoryCode>* ColumnStore::categoryColumnFor(int col) const {
+    switch (col) {
+        case COL_TRANSACTION_TYPE: return &transaction_type;
+        case COL_MERCHANT_CATEGORY: return &merchant_category;
+        case COL_LOCATION: return &location;
+        case COL_DEVICE_USED: return &device_used;
+        default: return &payment_channel;
+    }
+}
+
+const FixedColumn<double>* ColumnStore::doubleColumnFor(int col) const {
+    switch (col) {
+        case COL_AMOUNT: return &amount;
+        case COL_TIME_SINCE_LAST_TRANSACTION: return &time_since_last_transaction;
+        case COL_SPENDING_DEVIATION: return &spending_deviation;
+        default: return &geo_anomaly;
+    }
+}
+
+// Gathers the given rows of every column into a new store
+ColumnStore ColumnStore::select(const std::vector<int>& rows) const {
+    ColumnStore result(0);
+    result.size = (int)rows.size();
+    gather(transaction_id, rows, result.transaction_id);
+    gather(timestamp, rows, result.timestamp);
+    gather(sender_account, rows, result.sender_account);
+    gather(receiver_account, rows, result.receiver_account);
+    gather(amount, rows, result.amount);
+    gather(transaction_type, rows, result.transaction_type);
+    gather(merchant_category, rows, result.merchant_category);
+    gather(location, rows, result.location);
+    gather(device_used, rows, result.device_used);
+    gather(is_fraud, rows, result.is_fraud);
+    gather(fraud_type, rows, result.fraud_type);
+    gather(time_since_last_transaction, rows, result.time_since_last_transaction);
+    gather(spending_deviation, rows, result.spending_deviation);
+    gather(velocity_score, rows, result.velocity_score);
+    gather(geo_anomaly, rows, result.geo_anomaly);
+    gather(payment_channel, rows, result.payment_channel);
+    gather(ip_address, rows, result.ip_address);
+    gather(device_hash, rows, result.device_hash);
+    return result;
+}
+
+// Prints one row in the same format as the other stores
+static void printRow(const ColumnStore& store, int index) {
+    Transaction t = store.getTransaction(index);
+    std::cout << "ID: " << t.transaction_id
+              << ", Date: " << formatTimestamp(t.timestamp)
+              << ", Amount: " << t.amount
+              << ", Type: " << t.transactionTypeName()
+              << ", Location: " << t.locationName()
+              << ", Channel: " << t.paymentChannelName()
+              << std::endl;
+}
+
+// Displays the first transactions and optionally all of them
+void ColumnStore::display() const {
+    std::cout << "\n--- Transactions (Columnar) ---\n";
+
+    // Show first 10 transactions
+    int displayCount = (size > 10) ? 10 : size;
+    for (int i = 0; i < displayCount; ++i) {
+        printRow(*this, i);
+    }
+
+    // If there are more transactions, ask user if they want to see all
+    if (size > 10) {
+        std::cout << "... and " << (size - 10) << " more transactions\n";
+        std::cout << "Total: " << size << " transactions\n";
+        std::cout << "Show all transactions? (y/n): ";
+
+        char choice;
+        std::cin >> choice;
+
+        if (choice == 'y' || choice == 'Y') {
+            std::cout << "\n--- ALL TRANSACTIONS (Columnar) ---\n";
+            for (int i = 0; i < size; ++i) {
+                printRow(*this, i);
+            }
+            std::cout << "Total: " << size << " transactions\n";
+        }
+    } else {
+        std::cout << "Total: " << size << " transactions\n";
+    }
+
+    std::cout << "-------------------\n";
+}
+
+// Groups transactions by payment channel, scanning only the channel column
+ColumnStore ColumnStore::groupByPaymentChannel(const std::string& channel) const {
+    int code = dictionaryFor(COL_PAYMENT_CHANNEL).find(channel);
+    std::vector<int> rows;
+    const CategoryCode* channels = payment_channel.data();
+    for (int i = 0; i < size; ++i) {
+        if (channels[i] == code) rows.push_back(i);
+    }
+    return select(rows);
+}
+
+// Searches transactions by type, scanning only the type column
+ColumnStore ColumnStore::searchByTransactionType(const std::string& type) const {
+    int code = dictionaryFor(COL_TRANSACTION_TYPE).find(type);
+    std::vector<int> rows;
+    const CategoryCode* types = transaction_type.data();
+    for (int i = 0; i < size; ++i) {
+        if (types[i] == code) rows.push_back(i);
+    }
+    return select(rows);
+}
+
+// Gets all fraudulent transactions, scanning only the is_fraud column
+ColumnStore ColumnStore::getFraudulentTransactions() const {
+    std::vector<int> rows;
+    const uint8_t* flags = is_fraud.data();
+    for (int i = 0; i < size; ++i) {
+        if (flags[i]) rows.push_back(i);
+    }
+    return select(rows);
+}
+
+// Sorts by location: a stable sort of row numbers on the location column,
+// followed by a single gather of every column into the new order
+void ColumnStore::sortByLocation(SortStrategy strategy) {
+    if (size <= 1) return;
+    std::vector<int> rank = dictionaryFor(COL_LOCATION).sortedRanks();
+    const CategoryCode* locations = location.data();
+    std::vector<int> order(size);
+
+    if (strategy == SORT_COUNTING) {
+        // first position of each location, then one scatter pass over the codes
+        std::vector<int> next(rank.size() + 1, 0);
+        for (int i = 0; i < size; ++i) {
+            next[rank[locations[i]] + 1]++;
+        }
+        for (size_t r = 1; r < next.size(); ++r) {
+            next[r] += next[r - 1];
+        }
+        for (int i = 0; i < size; ++i) {
+            order[next[rank[locations[i]]]++] = i;
+        }
+    } else {
+        for (int i = 0; i < size; ++i) {
+            order[i] = i;
+        }
+        std::stable_sort(order.begin(), order.end(), [&rank, locations](int a, int b) {
+            return rank[locations[a]] < rank[locations[b]];
+        });
+    }
+    *this = select(order);
+}
+
+// Encodes each key one column at a time, then gathers every column in key order
+void ColumnStore::sortBy(const std::vector<SortKey>& keys) {
+    if (size <= 1) return;
+    SortKeyTable table(keys);
+    for (size_t k = 0; k < keys.size(); ++k) {
+        if (columnType(keys[k].column) == TYPE_STRING) {
+            const StringColumn* strings = stringColumnFor(keys[k].column);
+            for (int i = 0; i < size; ++i) {
+                table.fitString(k, strings->get(i).size);
+            }
+        }
+    }
+    table.allocate(size);
+
+    for (size_t k = 0; k < keys.size(); ++k) {
+        int col = keys[k].column;
+        switch (columnType(col)) {
+            case TYPE_STRING: {
+                const StringColumn* strings = stringColumnFor(col);
+                for (int i = 0; i < size; ++i) {
+                    StringRef value = strings->get(i);
+                    table.putString(i, k, value.data, value.size);
+                }
+                break;
+            }
+            case TYPE_CATEGORY: {
+                const FixedColumn<CategoryCode>* codes = categoryColumnFor(col);
+                for (int i = 0; i < size; ++i) table.putCode(i, k, (*codes)[i]);
+                break;
+            }
+            case TYPE_TIMESTAMP:
+                for (int i = 0; i < size; ++i) table.putInteger(i, k, timestamp[i]);
+                break;
+            case TYPE_INT:
+                for (int i = 0; i < size; ++i) table.putInteger(i, k, velocity_score[i]);
+                break;
+            case TYPE_BOOL:
+                for (int i = 0; i < size; ++i) table.putInteger(i, k, is_fraud[i]);
+                break;
+            default: {
+                const FixedColumn<double>* numbers = doubleColumnFor(col);
+                for (int i = 0; i < size; ++i) table.putDouble(i, k, (*numbers)[i]);
+                break;
+            }
+        }
+    }
+    *this = select(table.sortedOrder());
+}
+
+// Query access to a ColumnStore: a batch of a column is gathered straight from
+// its contiguous values
+class ColumnQuerySource : public QuerySource {
+private:
+    const ColumnStore& store;
+
+public:
+    explicit ColumnQuerySource(const ColumnStore& columns) : store(columns) {}
+
+    void gatherNumbers(int column, const int* rows, int count, double* out) const {
+        switch (column) {
+            case COL_TIMESTAMP: {
+                const int64_t* values = store.timestamp.data();
+                for (int i = 0; i < count; ++i) out[i] = (double)values[rows[i]];
+                return;
+            }
+            case COL_VELOCITY_SCORE: {
+                const int* values = store.velocity_score.data();
+                for (int i = 0; i < count; ++i) out[i] = values[rows[i]];
+                return;
+            }
+            case COL_IS_FRAUD: {
+                const uint8_t* values = store.is_fraud.data();
+                for (int i = 0; i < count; ++i) out[i] = values[rows[i]];
+                return;
+            }
+            default: {
+                const double* values = store.doubleColumnFor(column)->data();
+                for (int i = 0; i < count; ++i) out[i] = values[rows[i]];
+                return;
+            }
+        }
+    }
+
+    void gatherCodes(int column, const int* rows, int count, CategoryCode* out) const {
+        const CategoryCode* values = store.categoryColumnFor(column)->data();
+        for (int i = 0; i < count; ++i) out[i] = values[rows[i]];
+    }
+
+    StringRef text(int column, int row) const {
+        return store.stringColumnFor(column)->get(row);
+    }
+};
+
+// Finds the matching rows, then gathers them into a new store
+ColumnStore ColumnStore::where(const Query& query) const {
+    ColumnQuerySource source(*this);
+    return select(query.matchingRows(source, nullptr, size));
+}
+
+// Exports transactions to JSON format
+nlohmann::json ColumnStore::toJSON() const {
+    nlohmann::json j_array = nlohmann::json::array();
+    for (int i = 0; i < size; ++i) {
+        nlohmann::json j_trans = {
+            {"transaction_id", transaction_id.get(i).str()},
+            {"timestamp", formatTimestamp(timestamp[i])},
+            {"sender_account", sender_account.get(i).str()},
+            {"receiver_account", receiver_account.get(i).str()},
+            {"amount", amount[i]},
+            {"transaction_type", dictionaryFor(COL_TRANSACTION_TYPE).lookup(transaction_type[i])},
+            {"merchant_category", dictionaryFor(COL_MERCHANT_CATEGORY).lookup(merchant_category[i])},
+            {"location", dictionaryFor(COL_LOCATION).lookup(location[i])},
+            {"device_used", dictionaryFor(COL_DEVICE_USED).lookup(device_used[i])},
+            {"is_fraud", is_fraud[i] != 0},
+            {"fraud_type", fraud_type.get(i).str()},
+            {"time_since_last_transaction", time_since_last_transaction[i]}, // NaN is written as null
+            {"spending_deviation", spending_deviation[i]},
+            {"velocity_score", velocity_score[i]},
+            {"geo_anomaly", geo_anomaly[i]},
+            {"payment_channel", dictionaryFor(COL_PAYMENT_CHANNEL).lookup(payment_channel[i])},
+            {"ip_address", ip_address.get(i).str()},
+            {"device_hash", device_hash.get(i).str()}
+        };
+        j_array.push_back(j_trans);
+    }
+    return j_array;
+}
+
+// Binary snapshot layout. Everything is written in native byte order (the
+// header records it so a file from a different machine is rejected):
+//   SnapshotHeader
+//   SnapshotColumn[COLUMN_COUNT]  where each column's data lives
+//   column and dictionary data, each section starting on an 8-byte boundary
+// so that mapped int64/double columns are properly aligned.
+static const char SNAPSHOT_MAGIC[8] = {'F', 'D', 'S', 'N', 'A', 'P', '\0', '\0'};
+static const uint32_t SNAPSHOT_BYTE_ORDER = 0x01020304;
+static const uint32_t SNAPSHOT_VERSION = 1;
+static const uint64_t SNAPSHOT_ALIGNMENT = 8;
+
+// Byte range of one section, relative to the start of the file
+struct SnapshotSection {
+    uint64_t offset;
+    uint64_t length;
+};
+
+// Sections of one column (unused sections are left zero)
+struct SnapshotColumn {
+    SnapshotSection values;            // Fixed-width values, or the bytes of a string column
+    SnapshotSection offsets;           // String columns: rows + 1 uint64 offsets into values
+    SnapshotSection dictionaryBytes;   // Categorical columns: dictionary strings in code order
+    SnapshotSection dictionaryOffsets; // Categorical columns: dictionary size + 1 offsets
+};
+
+struct SnapshotHeader {
+    char magic[8];
+    uint32_t byteOrder;
+    uint32_t version;
+    uint64_t rows;
+    uint64_t columnCount;
+};
+
+// Appends aligned sections to the snapshot file and records where they went
+class SnapshotWriter {
+private:
+    std::ofstream& out;
+    uint64_t position; // Current file offset
+
+public:
+    SnapshotWriter(std::ofstream& stream, uint64_t start) : out(stream), position(start) {}
+
+    SnapshotSection write(const void* data, uint64_t length) {
+        static const char PADDING[SNAPSHOT_ALIGNMENT] = {0};
+        uint64_t padding = (SNAPSHOT_ALIGNMENT - position % SNAPSHOT_ALIGNMENT) % SNAPSHOT_ALIGNMENT;
+        out.write(PADDING, padding);
+        position += padding;
+        SnapshotSection section = { position, length };
+        out.write((const char*)data, length);
+        position += length;
+        return section;
+    }
+};
+
+template <typename T>
+static SnapshotSection writeFixed(SnapshotWriter& writer, const FixedColumn<T>& column) {
+    return writer.write(column.data(), column.size() * sizeof(T));
+}
+
+static void writeStrings(SnapshotWriter& writer, const StringColumn& column,
+                         SnapshotSection& bytes, SnapshotSection& offsets) {
+    bytes = writeFixed(writer, column.byteColumn());
+    offsets = writeFixed(writer, column.offsetColumn());
+}
+
+// Writes the column's global dictionary (code i is the i-th string)
+static void writeDictionary(SnapshotWriter& writer, int col, SnapshotColumn& entry) {
+    StringDictionary& dictionary = dictionaryFor(col);
+    StringColumn values;
+    for (int code = 0; code < dictionary.size(); ++code) {
+        values.push_back(dictionary.lookup((CategoryCode)code));
+    }
+    writeStrings(writer, values, entry.dictionaryBytes, entry.dictionaryOffsets);
+}
+
+// Writes to a temporary file first, so a snapshot that is currently mapped
+// (by this or another process) is replaced only once the new one is complete
+bool ColumnStore::saveSnapshot(const std::string& path) const {
+    std::string tempPath = path + ".tmp";
+    std::ofstream out(tempPath.c_str(), std::ios::binary | std::ios::trunc);
+    if (!out) return false;
+
+    SnapshotHeader header;
+    std::memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.byteOrder = SNAPSHOT_BYTE_ORDER;
+    header.version = SNAPSHOT_VERSION;
+    header.rows = size;
+    header.columnCount = COLUMN_COUNT;
+    SnapshotColumn table[COLUMN_COUNT];
+    std::memset(table, 0, sizeof(table));
+
+    // the column table is written twice: as a placeholder now, filled in at the end
+    out.write((const char*)&header, sizeof(header));
+    out.write((const char*)table, sizeof(table));
+    SnapshotWriter writer(out, sizeof(header) + sizeof(table));
+
+    writeStrings(writer, transaction_id, table[COL_TRANSACTION_ID].values, table[COL_TRANSACTION_ID].offsets);
+    table[COL_TIMESTAMP].values = writeFixed(writer, timestamp);
+    writeStrings(writer, sender_account, table[COL_SENDER_ACCOUNT].values, table[COL_SENDER_ACCOUNT].offsets);
+    writeStrings(writer, receiver_account, table[COL_RECEIVER_ACCOUNT].values, table[COL_RECEIVER_ACCOUNT].offsets);
+    table[COL_AMOUNT].values = writeFixed(writer, amount);
+    table[COL_TRANSACTION_TYPE].values = writeFixed(writer, transaction_type);
+    table[COL_MERCHANT_CATEGORY].values = writeFixed(writer, merchant_category);
+    table[COL_LOCATION].values = writeFixed(writer, location);
+    table[COL_DEVICE_USED].values = writeFixed(writer, device_used);
+    table[COL_IS_FRAUD].values = writeFixed(writer, is_fraud);
+    writeStrings(writer, fraud_type, table[COL_FRAUD_TYPE].values, table[COL_FRAUD_TYPE].offsets);
+    table[COL_TIME_SINCE_LAST_TRANSACTION].values = writeFixed(writer, time_since_last_transaction);
+    table[COL_SPENDING_DEVIATION].values = writeFixed(writer, spending_deviation);
+    table[COL_VELOCITY_SCORE].values = writeFixed(writer, velocity_score);
+    table[COL_GEO_ANOMALY].values = writeFixed(writer, geo_anomaly);
+    table[COL_PAYMENT_CHANNEL].values = writeFixed(writer, payment_channel);
+    writeStrings(writer, ip_address, table[COL_IP_ADDRESS].values, table[COL_IP_ADDRESS].offsets);
+    writeStrings(writer, device_hash, table[COL_DEVICE_HASH].values, table[COL_DEVICE_HASH].offsets);
+    for (int col = 0; col < COLUMN_COUNT; ++col) {
+        if (isCategorical(col)) writeDictionary(writer, col, table[col]);
+    }
+
+    out.seekp(sizeof(header));
+    out.write((const char*)table, sizeof(table));
+    out.close();
+    if (!out) {
+        std::remove(tempPath.c_str());
+        return false;
+    }
+    std::remove(path.c_str()); // rename() does not replace an existing file on Windows
+    return std::rename(tempPath.c_str(), path.c_str()) == 0;
+}
+
+// A mapped snapshot and the checks shared by every column
+class SnapshotReader {
+private:
+    const char* base;
+    uint64_t fileSize;
+
+public:
+    SnapshotReader(const MappedFile& file) : base(file.data()), fileSize(file.size()) {}
+
+    // Start of a section, or nullptr if it is misaligned or outside the file
+    const char* section(const SnapshotSection& s, uint64_t expectedLength) const {
+        if (s.length != expectedLength || s.offset % SNAPSHOT_ALIGNMENT != 0
+            || s.offset > fileSize || s.length > fileSize - s.offset) {
+            return nullptr;
+        }
+        return base + s.offset;
+    }
+};
+
+template <typename T>
+static bool borrowFixed(const SnapshotReader& reader, const SnapshotSection& s, uint64_t rows,
+                        FixedColumn<T>& column) {
+    const char* data = reader.section(s, rows * sizeof(T));
+    if (data == nullptr) return false;
+    column.borrow((const T*)data, rows);
+    return true;
+}
+
+// Only the first and last offsets are checked: the file is trusted to be one
+// written by saveSnapshot, and checking every offset would touch every page
+static bool borrowStrings(const SnapshotReader& reader, const SnapshotSection& bytesSection,
+                          const SnapshotSection& offsetsSection, uint64_t rows, StringColumn& column) {
+    const char* offsetData = reader.section(offsetsSection, (rows + 1) * sizeof(uint64_t));
+    if (offsetData == nullptr) return false;
+    const uint64_t* offsets = (const uint64_t*)offsetData;
+    const char* bytes = reader.section(bytesSection, bytesSection.length);
+    if (bytes == nullptr || offsets[0] != 0 || offsets[rows] != bytesSection.length) return false;
+    column.borrow(bytes, bytesSection.length, offsets, rows);
+    return true;
+}
+
+// Interns the snapshot's dictionary into the global one. If every code keeps
+// its value (the usual case in a fresh process) the code column is used in
+// place; otherwise it is copied with each code translated.
+static bool borrowCodes(const SnapshotReader& reader, const SnapshotColumn& entry, uint64_t rows,
+                        int col, FixedColumn<CategoryCode>& column) {
+    uint64_t offsetCount = entry.dictionaryOffsets.length / sizeof(uint64_t);
+    if (offsetCount == 0) return false;
+    StringColumn values;
+    if (!borrowStrings(reader, entry.dictionaryBytes, entry.dictionaryOffsets, offsetCount - 1, values)) {
+        return false;
+    }
+
+    std::vector<CategoryCode> remap(values.size());
+    bool identity = true;
+    try {
+        for (size_t code = 0; code < values.size(); ++code) {
+            StringRef value = values.get(code);
+            remap[code] = dictionaryFor(col).intern(value.data, value.size);
+            identity = identity && remap[code] == code;
+        }
+    } catch (const std::length_error&) {
+        return false;
+    }
+
+    const char* data = reader.section(entry.values, rows * sizeof(CategoryCode));
+    if (data == nullptr) return false;
+    const CategoryCode* codes = (const CategoryCode*)data;
+    if (identity) {
+        column.borrow(codes, rows);
+        return true;
+    }
+    column.reserve(rows);
+    for (uint64_t i = 0; i < rows; ++i) {
+        if (codes[i] >= remap.size()) return false;
+        column.push_back(remap[codes[i]]);
+    }
+    return true;
+}
+
+// Maps the file, checks the header and points every column into it
+bool ColumnStore::loadSnapshot(const std::string& path) {
+    std::shared_ptr<MappedFile> file = std::make_shared<MappedFile>();
+    if (!file->open(path)) return false;
+
+    SnapshotHeader header;
+    SnapshotColumn table[COLUMN_COUNT];
+    if (file->size() < sizeof(header) + sizeof(table)) return false;
+    std::memcpy(&header, file->data(), sizeof(header));
+    std::memcpy(table, file->data() + sizeof(header), sizeof(table));
+    if (std::memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic)) != 0
+        || header.byteOrder != SNAPSHOT_BYTE_ORDER || header.version != SNAPSHOT_VERSION
+        || header.columnCount != COLUMN_COUNT || header.rows > (uint64_t)std::numeric_limits<int>::max()) {
+        return false;
+    }
+
+    uint64_t rows = header.rows;
+    SnapshotReader reader(*file);
+    ColumnStore result(0);
+    result.size = (int)rows;
+    result.snapshot = file;
+    bool ok = borrowStrings(reader, table[COL_TRANSACTION_ID].values, table[COL_TRANSACTION_ID].offsets, rows, result.transaction_id)
+        && borrowFixed(reader, table[COL_TIMESTAMP].values, rows, result.timestamp)
+        && borrowStrings(reader, table[COL_SENDER_ACCOUNT].values, table[COL_SENDER_ACCOUNT].offsets, rows, result.sender_account)
+        && borrowStrings(reader, table[COL_RECEIVER_ACCOUNT].values, table[COL_RECEIVER_ACCOUNT].offsets, rows, result.receiver_account)
+        && borrowFixed(reader, table[COL_AMOUNT].values, rows, result.amount)
+        && borrowCodes(reader, table[COL_TRANSACTION_TYPE], rows, COL_TRANSACTION_TYPE, result.transaction_type)
+        && borrowCodes(reader, table[COL_MERCHANT_CATEGORY], rows, COL_MERCHANT_CATEGORY, result.merchant_category)
+        && borrowCodes(reader, table[COL_LOCATION], rows, COL_LOCATION, result.location)
+        && borrowCodes(reader, table[COL_DEVICE_USED], rows, COL_DEVICE_USED, result.device_used)
+        && borrowFixed(reader, table[COL_IS_FRAUD].values, rows, result.is_fraud)
+        && borrowStrings(reader, table[COL_FRAUD_TYPE].values, table[COL_FRAUD_TYPE].offsets, rows, result.fraud_type)
+        && borrowFixed(reader, table[COL_TIME_SINCE_LAST_TRANSACTION].values, rows, result.time_since_last_transaction)
+        && borrowFixed(reader, table[COL_SPENDING_DEVIATION].values, rows, result.spending_deviation)
+        && borrowFixed(reader, table[COL_VELOCITY_SCORE].values, rows, result.velocity_score)
+        && borrowFixed(reader, table[COL_GEO_ANOMALY].values, rows, result.geo_anomaly)
+        && borrowCodes(reader, table[COL_PAYMENT_CHANNEL], rows, COL_PAYMENT_CHANNEL, result.payment_channel)
+        && borrowStrings(reader, table[COL_IP_ADDRESS].values, table[COL_IP_ADDRESS].offsets, rows, result.ip_address)
+        && borrowStrings(reader, table[COL_DEVICE_HASH].values, table[COL_DEVICE_HASH].offsets, rows, result.device_hash);
+    if (!ok) return false;
+
+    *this = std::move(result);
+    return true;
+}
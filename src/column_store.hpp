@@ -0,0 +1,183 @@
+#ifndef COLUMN_STORE_HPP
+#define COLUMN_STORE_HPP
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <memory>
+#include "../lib/json.hpp" // For JSON export
+#include "transaction.hpp"
+#include "transaction_view.hpp" // StringRef
+#include "mapped_file.hpp"
+#include "sort_key.hpp"
+#include "query.hpp"
+
+// Fixed-width values in one contiguous array, either owned or borrowed from a
+// mapped snapshot file. A borrowed column is read-only until the first append,
+// which copies it into owned storage.
+template <typename T>
+class FixedColumn {
+private:
+    std::vector<T> owned;
+    const T* borrowed;    // Borrowed values (nullptr when owned)
+    size_t borrowedCount;
+
+    // Copy borrowed values into owned storage before modifying them
+    void own() {
+        if (borrowed != nullptr) {
+            owned.assign(borrowed, borrowed + borrowedCount);
+            borrowed = nullptr;
+            borrowedCount = 0;
+        }
+    }
+
+public:
+    FixedColumn() : borrowed(nullptr), borrowedCount(0) {}
+
+    // Use count values owned by someone else (they must outlive this column)
+    void borrow(const T* values, size_t count) {
+        owned.clear();
+        borrowed = values;
+        borrowedCount = count;
+    }
+
+    // Append one value, or count values
+    void push_back(const T& value) {
+        own();
+        owned.push_back(value);
+    }
+    void append(const T* values, size_t count) {
+        own();
+        owned.insert(owned.end(), values, values + count);
+    }
+
+    const T* data() const { return borrowed != nullptr ? borrowed : owned.data(); }
+    size_t size() const { return borrowed != nullptr ? borrowedCount : owned.size(); }
+    const T& operator[](size_t i) const { return data()[i]; }
+
+    // Preallocate room for count values
+    void reserve(size_t count) {
+        own();
+        owned.reserve(count);
+    }
+};
+
+// Variable-length strings stored back to back in one contiguous buffer
+class StringColumn {
+private:
+    FixedColumn<char> bytes;        // All values concatenated
+    FixedColumn<uint64_t> offsets;  // Value i is bytes[offsets[i], offsets[i + 1])
+
+public:
+    StringColumn();
+
+    // Append a value
+    void push_back(const char* data, size_t length);
+    void push_back(const std::string& value);
+
+    // Bytes of value i
+    StringRef get(size_t i) const;
+
+    // Number of values
+    size_t size() const;
+
+    // Preallocate room for rows values totalling byteCount bytes
+    void reserve(size_t rows, size_t byteCount);
+
+    // Underlying buffers, for writing and borrowing snapshots
+    const FixedColumn<char>& byteColumn() const { return bytes; }
+    const FixedColumn<uint64_t>& offsetColumn() const { return offsets; }
+    void borrow(const char* byteData, size_t byteCount, const uint64_t* offsetData, size_t rows);
+};
+
+// Columnar (structure-of-arrays) store: every field lives in its own
+// contiguous column, so a scan over one field touches only that field's bytes.
+// Numeric columns are stored as real doubles and categorical columns as
+// dictionary codes. Offers the same operations as ArrayStore, and can be saved
+// to and restored from a binary snapshot file.
+class ColumnStore {
+private:
+    int size; // Number of rows
+    std::shared_ptr<const MappedFile> snapshot; // Keeps borrowed columns alive (may be null)
+
+    StringColumn transaction_id;
+    FixedColumn<int64_t> timestamp;                  // Epoch microseconds
+    StringColumn sender_account;
+    StringColumn receiver_account;
+    FixedColumn<double> amount;
+    FixedColumn<CategoryCode> transaction_type;
+    FixedColumn<CategoryCode> merchant_category;
+    FixedColumn<CategoryCode> location;
+    FixedColumn<CategoryCode> device_used;
+    FixedColumn<uint8_t> is_fraud;                   // 0 or 1
+    StringColumn fraud_type;
+    FixedColumn<double> time_since_last_transaction; // NaN when missing
+    FixedColumn<double> spending_deviation;
+    FixedColumn<int> velocity_score;
+    FixedColumn<double> geo_anomaly;
+    FixedColumn<CategoryCode> payment_channel;
+    StringColumn ip_address;
+    StringColumn device_hash;
+
+    // Build a new store holding the given rows, in the given order
+    ColumnStore select(const std::vector<int>& rows) const;
+
+    // Columns by TransactionColumn (col must have the matching columnType)
+    const StringColumn* stringColumnFor(int col) const;
+    const FixedColumn<CategoryCode>* categoryColumnFor(int col) const;
+    const FixedColumn<double>* doubleColumnFor(int col) const;
+
+    // Reads the columns directly when a query runs
+    friend class ColumnQuerySource;
+
+public:
+    // Constructor: empty store with room for max_size rows
+    ColumnStore(int max_size = 1000);
+
+    // Add a transaction (each field is appended to its column)
+    void addTransaction(const Transaction& t);
+
+    // Rebuild row index as an owning Transaction
+    Transaction getTransaction(int index) const;
+
+    // Group transactions by payment channel (returns a new ColumnStore)
+    ColumnStore groupByPaymentChannel(const std::string& channel) const;
+
+    // Sort transactions by location (ascending, stable)
+    void sortByLocation(SortStrategy strategy = SORT_MERGE);
+
+    // Sort by several columns, each ascending or descending (stable); keys
+    // are encoded straight from the columns
+    void sortBy(const std::vector<SortKey>& keys);
+
+    // Rows matching every predicate of query (returns a new ColumnStore)
+    ColumnStore where(const Query& query) const;
+
+    // Search for transactions by type (returns a new ColumnStore)
+    ColumnStore searchByTransactionType(const std::string& type) const;
+
+    // Export transactions to JSON
+    nlohmann::json toJSON() const;
+
+    // Display transactions to console
+    void display() const;
+
+    // Get the number of transactions
+    int getSize() const;
+
+    // Get fraudulent transactions
+    ColumnStore getFraudulentTransactions() const;
+
+    // Write every column and the dictionaries of the categorical columns to a
+    // binary snapshot file; returns false if the file cannot be written
+    bool saveSnapshot(const std::string& path) const;
+
+    // Replace the contents with a snapshot written by saveSnapshot. The file is
+    // memory-mapped and its columns are used in place, so this does not parse
+    // or copy rows; only categorical columns whose codes differ from the
+    // process-wide dictionaries are copied and remapped. Returns false if the
+    // file cannot be mapped or is not a valid snapshot.
+    bool loadSnapshot(const std::string& path);
+};
+
+#endif // COLUMN_STORE_HPP
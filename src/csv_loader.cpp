@@ -0,0 +1,438 @@
+#include "csv_loader.hpp"
+#include "mapped_file.hpp"
+#include "csv_scanner.hpp"
+#include "numeric_parse.hpp"
+#include "timestamp.hpp"
+#include <iostream>
+#include <chrono>
+#include <cstring>
+#include <thread>
+#include <vector>
+#include <memory>
+#include <stdexcept>
+#include <limits>
+
+// String members of Transaction in CSV column order (nullptr for the typed
+// numeric and dictionary-encoded columns)
+static std::string Transaction::* const STRING_COLUMNS[COLUMN_COUNT] = {
+    &Transaction::transaction_id,
+    nullptr, // timestamp
+    &Transaction::sender_account,
+    &Transaction::receiver_account,
+    nullptr, // amount
+    nullptr, // transaction_type
+    nullptr, // merchant_category
+    nullptr, // location
+    nullptr, // device_used
+    nullptr, // is_fraud
+    &Transaction::fraud_type,
+    nullptr, // time_since_last_transaction
+    nullptr, // spending_deviation
+    nullptr, // velocity_score
+    nullptr, // geo_anomaly
+    nullptr, // payment_channel
+    &Transaction::ip_address,
+    &Transaction::device_hash
+};
+
+// Dictionary-encoded members of Transaction in CSV column order
+static CategoryCode Transaction::* const CATEGORY_COLUMNS[COLUMN_COUNT] = {
+    nullptr, nullptr, nullptr, nullptr, nullptr,
+    &Transaction::transaction_type,
+    &Transaction::merchant_category,
+    &Transaction::location,
+    &Transaction::device_used,
+    nullptr, nullptr, nullptr, nullptr, nullptr, nullptr,
+    &Transaction::payment_channel,
+    nullptr, nullptr
+};
+
+// Dictionaries a parser interns categorical columns into, indexed by column
+typedef StringDictionary* DictionaryTable[COLUMN_COUNT];
+
+// Points every categorical column at its process-wide dictionary
+static void useGlobalDictionaries(DictionaryTable& table) {
+    for (int col = 0; col < COLUMN_COUNT; ++col) {
+        table[col] = isCategorical(col) ? &dictionaryFor(col) : nullptr;
+    }
+}
+
+// Returns the position just past the next newline at or after p that is not
+// inside double quotes (or end), the record boundary CsvScanner would find.
+// inQuotes is the quote state at p and becomes the state at the result.
+static const char* nextRecordStart(const char* p, const char* end, bool& inQuotes) {
+    for (; p < end; ++p) {
+        if (*p == '"') inQuotes = !inQuotes;
+        else if (*p == '\n' && !inQuotes) return p + 1;
+    }
+    return end;
+}
+
+// Same, starting outside quotes (at the start of a record)
+static const char* nextRecordStart(const char* p, const char* end) {
+    bool inQuotes = false;
+    return nextRecordStart(p, end, inQuotes);
+}
+
+// Flips inQuotes once for every quote in [p, target)
+static void skipQuotedState(const char* p, const char* target, bool& inQuotes) {
+    while (p < target && (p = (const char*)std::memchr(p, '"', target - p)) != nullptr) {
+        inQuotes = !inQuotes;
+        ++p;
+    }
+}
+
+// Numeric members of Transaction stored as doubles
+static double Transaction::* doubleMember(int col) {
+    switch (col) {
+        case COL_AMOUNT: return &Transaction::amount;
+        case COL_TIME_SINCE_LAST_TRANSACTION: return &Transaction::time_since_last_transaction;
+        case COL_SPENDING_DEVIATION: return &Transaction::spending_deviation;
+        case COL_GEO_ANOMALY: return &Transaction::geo_anomaly;
+        default: return nullptr;
+    }
+}
+
+// Parses one unquoted field into its typed member of t
+static bool assignTypedField(int col, const char* b, const char* e, Transaction& t) {
+    switch (columnType(col)) {
+        case TYPE_TIMESTAMP:
+            return parseTimestamp(b, e, t.timestamp);
+        case TYPE_DOUBLE:
+            return parseDouble(b, e, t.*doubleMember(col));
+        case TYPE_NULLABLE_DOUBLE:
+            if (b == e) {
+                t.*doubleMember(col) = std::numeric_limits<double>::quiet_NaN();
+                return true;
+            }
+            return parseDouble(b, e, t.*doubleMember(col));
+        case TYPE_INT:
+            return parseInt(b, e, t.velocity_score);
+        case TYPE_BOOL:
+            return parseBool(b, e, t.is_fraud);
+        default:
+            return false;
+    }
+}
+
+// Fills t from the scanned field spans of one record
+static bool assignFields(const FieldSpan* fields, int fieldCount, Transaction& t,
+                         const DictionaryTable& dictionaries) {
+    // columns missing from a short row are treated as empty fields, so only the
+    // string, categorical and nullable columns may be missing
+    if (fieldCount <= COL_AMOUNT) return false;
+    int present = fieldCount < COLUMN_COUNT ? fieldCount : COLUMN_COUNT;
+
+    try {
+        for (int col = 0; col < COLUMN_COUNT; ++col) {
+            const char* b = "";
+            const char* e = b;
+            if (col < present) {
+                b = fields[col].begin;
+                e = fields[col].end;
+                unquoteSpan(b, e);
+            }
+            // a quoted value may hold doubled quotes, collapsed in a copy
+            std::string unquoted;
+            bool text = STRING_COLUMNS[col] != nullptr || CATEGORY_COLUMNS[col] != nullptr;
+            if (text && std::memchr(b, '"', e - b) != nullptr) {
+                appendUnquoted(unquoted, b, e);
+                b = unquoted.data();
+                e = b + unquoted.size();
+            }
+            if (STRING_COLUMNS[col] != nullptr) {
+                (t.*STRING_COLUMNS[col]).assign(b, e - b);
+            } else if (CATEGORY_COLUMNS[col] != nullptr) {
+                t.*CATEGORY_COLUMNS[col] = dictionaries[col]->intern(b, e - b);
+            } else if (!assignTypedField(col, b, e, t)) {
+                return false; // a numeric or boolean column that does not parse
+            }
+        }
+    } catch (const std::length_error&) {
+        return false; // a "categorical" column with more than 65536 distinct values
+    }
+    return true;
+}
+
+// Parses one record with the vectorized scanner
+bool parseTransactionBytes(const char* begin, const char* end, Transaction& t) {
+    CsvScanner scanner(begin, end);
+    FieldSpan fields[COLUMN_COUNT];
+    int fieldCount = 0;
+    if (!scanner.nextRecord(fields, COLUMN_COUNT, fieldCount)) return false;
+    DictionaryTable dictionaries;
+    useGlobalDictionaries(dictionaries);
+    return assignFields(fields, fieldCount, t, dictionaries);
+}
+
+// Loads the CSV through a read-only memory mapping
+bool loadTransactionsMapped(const std::string& path, int maxRows,
+                            ArrayStore& arrayStore, LinkedListStore& linkedListStore,
+                            LoadStats& stats) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    MappedFile file;
+    if (!file.open(path)) {
+        return false;
+    }
+
+    const char* cursor = file.data();
+    const char* end = cursor + file.size();
+
+    cursor = nextRecordStart(cursor, end); // skip header
+
+    Transaction t; // reused for every row so its string buffers are recycled
+    stats = LoadStats();
+
+    CsvScanner scanner(cursor, end);
+    FieldSpan fields[COLUMN_COUNT];
+    int fieldCount = 0;
+    DictionaryTable dictionaries;
+    useGlobalDictionaries(dictionaries);
+
+    while ((maxRows == -1 || stats.rows < maxRows) && scanner.nextRecord(fields, COLUMN_COUNT, fieldCount)) {
+        if (scanner.recordBegin() == scanner.recordEnd()) continue; // empty line
+
+        if (assignFields(fields, fieldCount, t, dictionaries)) {
+            arrayStore.addTransaction(t);
+            linkedListStore.addTransaction(t);
+            stats.rows++;
+
+            // progress indicator for large loads
+            if (stats.rows % 10000 == 0) {
+                std::cout << "Loaded " << stats.rows << " rows...\n";
+            }
+        } else {
+            std::cout << "Error parsing line: "
+                      << std::string(scanner.recordBegin(), scanner.recordEnd() - scanner.recordBegin()) << std::endl;
+            stats.errors++;
+        }
+    }
+
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return true;
+}
+
+// Rows and rejected lines produced by one worker of the parallel loader.
+// Categorical codes in rows refer to the chunk's private dictionaries and are
+// remapped to the process-wide codes when the chunk is merged.
+struct ParsedChunk {
+    std::vector<Transaction> rows;
+    std::vector<std::string> errors;
+    std::vector<StringDictionary> dictionaries;
+};
+
+// Parses every non-empty line in [begin, end) into chunk
+static void parseChunk(const char* begin, const char* end, ParsedChunk* chunk) {
+    // rough rows-per-byte guess so the vector rarely has to grow
+    chunk->rows.reserve((end - begin) / 128 + 1);
+    chunk->dictionaries.resize(COLUMN_COUNT);
+    DictionaryTable dictionaries;
+    for (int col = 0; col < COLUMN_COUNT; ++col) {
+        dictionaries[col] = &chunk->dictionaries[col];
+    }
+
+    Transaction t;
+    CsvScanner scanner(begin, end);
+    FieldSpan fields[COLUMN_COUNT];
+    int fieldCount = 0;
+    while (scanner.nextRecord(fields, COLUMN_COUNT, fieldCount)) {
+        if (scanner.recordBegin() == scanner.recordEnd()) continue; // empty line
+        if (assignFields(fields, fieldCount, t, dictionaries)) {
+            chunk->rows.push_back(t);
+        } else {
+            chunk->errors.push_back(std::string(scanner.recordBegin(), scanner.recordEnd() - scanner.recordBegin()));
+        }
+    }
+}
+
+// Returns the end of the first count non-empty records from begin (end if
+// the input runs out first), found with the same scanner the parser uses
+static const char* skipRecords(const char* begin, const char* end, int count) {
+    CsvScanner scanner(begin, end);
+    FieldSpan fields[1];
+    int fieldCount = 0;
+    int records = 0;
+    while (records < count && scanner.nextRecord(fields, 1, fieldCount)) {
+        if (scanner.recordBegin() != scanner.recordEnd()) records++; // empty lines are skipped by the parser too
+    }
+    return records < count || scanner.recordEnd() >= end ? end : scanner.recordEnd() + 1;
+}
+
+// Parses [begin, end) (which starts at a record) on up to numThreads threads
+// and appends the rows to both stores in file order
+static void loadRangeParallel(const char* begin, const char* end, int numThreads,
+                              ArrayStore& arrayStore, LinkedListStore& linkedListStore,
+                              LoadStats& stats) {
+    // keep ranges large enough that thread start-up is not the dominant cost
+    size_t bytes = end - begin;
+    const size_t MIN_CHUNK_BYTES = 1 << 20;
+    if (bytes / MIN_CHUNK_BYTES < (size_t)numThreads) {
+        numThreads = (int)(bytes / MIN_CHUNK_BYTES) + 1;
+    }
+
+    // split into ranges whose boundaries are moved forward to the next record
+    // start; the quote state is carried along so a newline inside a quoted
+    // field is not mistaken for one
+    std::vector<const char*> bounds(numThreads + 1);
+    bounds[0] = begin;
+    const char* scanned = begin;
+    bool inQuotes = false;
+    for (int i = 1; i < numThreads; ++i) {
+        const char* guess = begin + bytes * i / numThreads;
+        if (guess - 1 > scanned) {
+            skipQuotedState(scanned, guess - 1, inQuotes);
+            scanned = guess - 1;
+        }
+        bounds[i] = nextRecordStart(scanned, end, inQuotes);
+        scanned = bounds[i];
+    }
+    bounds[numThreads] = end;
+
+    std::vector<ParsedChunk> chunks(numThreads);
+    std::vector<std::thread> workers;
+    for (int i = 1; i < numThreads; ++i) {
+        workers.push_back(std::thread(parseChunk, bounds[i], bounds[i + 1], &chunks[i]));
+    }
+    parseChunk(bounds[0], bounds[1], &chunks[0]); // the calling thread takes the first range
+    for (size_t i = 0; i < workers.size(); ++i) {
+        workers[i].join();
+    }
+
+    // merge in range order so rows keep their position in the file
+    size_t total = 0;
+    for (int i = 0; i < numThreads; ++i) {
+        total += chunks[i].rows.size();
+    }
+    arrayStore.reserve(arrayStore.getSize() + (int)total);
+
+    for (int i = 0; i < numThreads; ++i) {
+        for (size_t e = 0; e < chunks[i].errors.size(); ++e) {
+            std::cout << "Error parsing line: " << chunks[i].errors[e] << std::endl;
+        }
+        stats.errors += (int)chunks[i].errors.size();
+
+        // translate the chunk's private codes into process-wide codes
+        std::vector<CategoryCode> remap[COLUMN_COUNT];
+        for (int col = 0; col < COLUMN_COUNT; ++col) {
+            if (CATEGORY_COLUMNS[col] == nullptr) continue;
+            const StringDictionary& local = chunks[i].dictionaries[col];
+            for (int code = 0; code < local.size(); ++code) {
+                remap[col].push_back(dictionaryFor(col).intern(local.lookup((CategoryCode)code)));
+            }
+        }
+
+        std::vector<Transaction>& rows = chunks[i].rows;
+        for (size_t r = 0; r < rows.size(); ++r) {
+            for (int col = 0; col < COLUMN_COUNT; ++col) {
+                if (CATEGORY_COLUMNS[col] != nullptr) {
+                    rows[r].*CATEGORY_COLUMNS[col] = remap[col][rows[r].*CATEGORY_COLUMNS[col]];
+                }
+            }
+            linkedListStore.addTransaction(rows[r]);
+            arrayStore.addTransaction(std::move(rows[r]));
+        }
+        stats.rows += (int)rows.size();
+        std::vector<Transaction>().swap(rows); // release the chunk as soon as it is merged
+    }
+}
+
+// Loads the CSV by parsing record-aligned byte ranges on worker threads
+bool loadTransactionsParallel(const std::string& path, int maxRows, int numThreads,
+                              ArrayStore& arrayStore, LinkedListStore& linkedListStore,
+                              LoadStats& stats) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    MappedFile file;
+    if (!file.open(path)) {
+        return false;
+    }
+
+    const char* end = file.data() + file.size();
+    const char* cursor = nextRecordStart(file.data(), end); // skip header
+
+    if (numThreads <= 0) {
+        numThreads = (int)std::thread::hardware_concurrency();
+        if (numThreads <= 0) numThreads = 1;
+    }
+
+    // a row limit counts parsed rows, as the sequential loaders do: each round
+    // parses just enough records to reach it if none fail, and rejected
+    // records are made up by the next round (scanning for record ends runs
+    // far faster than parsing, so the extra passes are cheap)
+    stats = LoadStats();
+    while (cursor < end && (maxRows == -1 || stats.rows < maxRows)) {
+        const char* rangeEnd = maxRows == -1 ? end : skipRecords(cursor, end, maxRows - stats.rows);
+        loadRangeParallel(cursor, rangeEnd, numThreads, arrayStore, linkedListStore, stats);
+        cursor = rangeEnd;
+    }
+
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return true;
+}
+
+// Records unquoted field positions instead of copying the bytes (quotes
+// inside a quoted value stay doubled; TransactionView collapses them)
+static bool assignViewFields(const char* row, const FieldSpan* fields, int fieldCount,
+                             TransactionView& v) {
+    if (fieldCount <= COL_AMOUNT) return false;
+    int present = fieldCount < COLUMN_COUNT ? fieldCount : COLUMN_COUNT;
+
+    v.row = row;
+    v.amount = 0.0;
+    for (int col = 0; col < present; ++col) {
+        const char* b = fields[col].begin;
+        const char* e = fields[col].end;
+        unquoteSpan(b, e);
+        // offsets are 16-bit, so rows longer than 64 KB cannot be viewed
+        if (e - row > 0xFFFF) return false;
+        v.fields[col].offset = (uint16_t)(b - row);
+        v.fields[col].length = (uint16_t)(e - b);
+        if (col == COL_AMOUNT && !parseDouble(b, e, v.amount)) return false;
+    }
+    for (int col = present; col < COLUMN_COUNT; ++col) {
+        v.fields[col].offset = 0;
+        v.fields[col].length = 0;
+    }
+    // velocity_score must be an integer, as parseTransactionBytes requires (a
+    // missing one is empty and fails too), so velocityScore() never guesses
+    int velocity;
+    const char* velocityBegin = row + v.fields[COL_VELOCITY_SCORE].offset;
+    return parseInt(velocityBegin, velocityBegin + v.fields[COL_VELOCITY_SCORE].length, velocity);
+}
+
+// Loads zero-copy views over a memory-mapped CSV file
+bool loadTransactionViews(const std::string& path, int maxRows, ViewStore& store,
+                          LoadStats& stats) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    std::shared_ptr<MappedFile> file = std::make_shared<MappedFile>();
+    if (!file->open(path)) {
+        return false;
+    }
+    store.setBuffer(file);
+
+    const char* end = file->data() + file->size();
+    const char* cursor = nextRecordStart(file->data(), end); // skip header
+
+    stats = LoadStats();
+    CsvScanner scanner(cursor, end);
+    FieldSpan fields[COLUMN_COUNT];
+    int fieldCount = 0;
+    TransactionView v;
+
+    while ((maxRows == -1 || stats.rows < maxRows) && scanner.nextRecord(fields, COLUMN_COUNT, fieldCount)) {
+        if (scanner.recordBegin() == scanner.recordEnd()) continue; // empty line
+        if (assignViewFields(scanner.recordBegin(), fields, fieldCount, v)) {
+            store.addView(v);
+            stats.rows++;
+        } else {
+            std::cout << "Error parsing line: "
+                      << std::string(scanner.recordBegin(), scanner.recordEnd() - scanner.recordBegin()) << std::endl;
+            stats.errors++;
+        }
+    }
+
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return true;
+}
@@ -0,0 +1,54 @@
+#ifndef CSV_LOADER_HPP
+#define CSV_LOADER_HPP
+
+#include <string>
+#include "transaction.hpp"
+#include "array_store.hpp"
+#include "linked_list_store.hpp"
+#include "view_store.hpp"
+
+// Timing and row counts reported by a CSV load
+struct LoadStats {
+    int rows;        // Rows parsed and stored
+    int errors;      // Rows skipped because they failed to parse
+    double seconds;  // Wall-clock time spent loading
+
+    LoadStats() : rows(0), errors(0), seconds(0.0) {}
+
+    // Throughput of the load (0 when nothing was timed)
+    double rowsPerSecond() const {
+        return seconds > 0.0 ? rows / seconds : 0.0;
+    }
+};
+
+// Parse one CSV record in [begin, end) into t without building temporary strings.
+// Fields are located by CsvScanner and unquoted like parseTransaction (commas
+// and newlines inside double quotes do not split a field, and doubled quotes
+// collapse); t's string buffers are reused, so parsing into the same
+// Transaction does not allocate.
+// The timestamp, numeric and boolean columns are parsed to their typed members
+// (an empty time_since_last_transaction becomes NaN). Returns false if any of
+// them is missing or does not parse.
+bool parseTransactionBytes(const char* begin, const char* end, Transaction& t);
+
+// Load up to maxRows rows (-1 = all) from a CSV file by memory-mapping it and
+// walking the bytes directly. The header line is skipped.
+bool loadTransactionsMapped(const std::string& path, int maxRows,
+                            ArrayStore& arrayStore, LinkedListStore& linkedListStore,
+                            LoadStats& stats);
+
+// Load up to maxRows rows (-1 = all) using numThreads workers (0 = one per core).
+// The mapped file is split into byte ranges that start and end on record
+// boundaries (newlines inside quoted fields do not split), each range is parsed
+// on its own thread, and the per-range results are appended to the stores in
+// original row order. Loads the same rows as loadTransactionsMapped.
+bool loadTransactionsParallel(const std::string& path, int maxRows, int numThreads,
+                              ArrayStore& arrayStore, LinkedListStore& linkedListStore,
+                              LoadStats& stats);
+
+// Load up to maxRows rows (-1 = all) as zero-copy views. The mapped file is
+// handed to the store and stays alive as long as any store references it.
+bool loadTransactionViews(const std::string& path, int maxRows, ViewStore& store,
+                          LoadStats& stats);
+
+#endif // CSV_LOADER_HPP
@@ -0,0 +1,186 @@
+#include "csv_scanner.hpp"
+#include "bit_ops.hpp"
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define CSV_SCANNER_X86 1
+#include <emmintrin.h>
+#if defined(__GNUC__)
+#define CSV_SCANNER_AVX2 1
+#include <immintrin.h>
+#endif
+#endif
+
+// Size of one scanned block: one bit per byte in a uint64_t mask
+static const int BLOCK_SIZE = 64;
+
+// Comma, newline and quote bitmasks for one 64-byte block
+struct BlockMasks {
+    uint64_t commas;
+    uint64_t newlines;
+    uint64_t quotes;
+};
+
+// Turns quote positions into a mask of bytes that lie between an opening and a
+// closing quote (each bit becomes the xor of all quote bits at or below it)
+static inline uint64_t prefixXor(uint64_t bits) {
+    bits ^= bits << 1;
+    bits ^= bits << 2;
+    bits ^= bits << 4;
+    bits ^= bits << 8;
+    bits ^= bits << 16;
+    bits ^= bits << 32;
+    return bits;
+}
+
+#ifndef CSV_SCANNER_X86
+
+// Portable fallback: classify one byte at a time
+static BlockMasks classifyScalar(const char* p) {
+    BlockMasks m = {0, 0, 0};
+    for (int i = 0; i < BLOCK_SIZE; ++i) {
+        uint64_t bit = (uint64_t)1 << i;
+        if (p[i] == ',') m.commas |= bit;
+        else if (p[i] == '\n') m.newlines |= bit;
+        else if (p[i] == '"') m.quotes |= bit;
+    }
+    return m;
+}
+
+#else
+
+// SSE2: four 16-byte compares per character class
+static BlockMasks classifySSE2(const char* p) {
+    const __m128i comma = _mm_set1_epi8(',');
+    const __m128i newline = _mm_set1_epi8('\n');
+    const __m128i quote = _mm_set1_epi8('"');
+    BlockMasks m = {0, 0, 0};
+    for (int i = 0; i < BLOCK_SIZE; i += 16) {
+        __m128i bytes = _mm_loadu_si128((const __m128i*)(p + i));
+        m.commas |= (uint64_t)(uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, comma)) << i;
+        m.newlines |= (uint64_t)(uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, newline)) << i;
+        m.quotes |= (uint64_t)(uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, quote)) << i;
+    }
+    return m;
+}
+
+#endif
+
+#ifdef CSV_SCANNER_AVX2
+
+// AVX2: two 32-byte compares per character class (compiled for AVX2 only here,
+// so the rest of the program still runs on CPUs without it)
+__attribute__((target("avx2")))
+static BlockMasks classifyAVX2(const char* p) {
+    const __m256i comma = _mm256_set1_epi8(',');
+    const __m256i newline = _mm256_set1_epi8('\n');
+    const __m256i quote = _mm256_set1_epi8('"');
+    __m256i lo = _mm256_loadu_si256((const __m256i*)p);
+    __m256i hi = _mm256_loadu_si256((const __m256i*)(p + 32));
+    BlockMasks m;
+    m.commas = (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(lo, comma))
+             | (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(hi, comma)) << 32;
+    m.newlines = (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(lo, newline))
+               | (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(hi, newline)) << 32;
+    m.quotes = (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(lo, quote))
+             | (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(hi, quote)) << 32;
+    return m;
+}
+
+// Queries the running CPU (cpu_init makes this safe during static initialization)
+static bool detectAVX2() {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+}
+
+// Checked once: whether the running CPU supports AVX2
+static const bool HAS_AVX2 = detectAVX2();
+
+#endif
+
+// Picks the widest classifier available on this CPU
+static inline BlockMasks classifyBlock(const char* p) {
+#if defined(CSV_SCANNER_AVX2)
+    if (HAS_AVX2) return classifyAVX2(p);
+    return classifySSE2(p);
+#elif defined(CSV_SCANNER_X86)
+    return classifySSE2(p);
+#else
+    return classifyScalar(p);
+#endif
+}
+
+// Constructor: positions the scanner on the first block
+CsvScanner::CsvScanner(const char* begin, const char* end) {
+    inputEnd = end;
+    cursor = begin;
+    blockBase = begin;
+    delimiters = 0;
+    quoteCarry = 0;
+    lastBegin = begin;
+    lastEnd = begin;
+    if (blockBase < inputEnd) loadBlock();
+}
+
+// Classifies the block at blockBase and keeps only the unquoted delimiters
+void CsvScanner::loadBlock() {
+    BlockMasks m;
+    size_t remaining = inputEnd - blockBase;
+    if (remaining >= (size_t)BLOCK_SIZE) {
+        m = classifyBlock(blockBase);
+    } else {
+        // the tail is copied into a zero-padded block so loads never run past the buffer
+        char padded[BLOCK_SIZE];
+        std::memset(padded, 0, sizeof(padded));
+        std::memcpy(padded, blockBase, remaining);
+        m = classifyBlock(padded);
+    }
+
+    uint64_t quoted = prefixXor(m.quotes) ^ quoteCarry;
+    // the top bit says whether the block ends inside quotes; spread it to all 64 bits
+    quoteCarry = (uint64_t)0 - (quoted >> 63);
+    delimiters = (m.commas | m.newlines) & ~quoted;
+}
+
+// Walks delimiter bits until the next unquoted newline
+bool CsvScanner::nextRecord(FieldSpan* fields, int maxFields, int& fieldCount) {
+    if (cursor >= inputEnd) return false;
+
+    const char* fieldStart = cursor;
+    fieldCount = 0;
+    lastBegin = cursor;
+
+    while (true) {
+        while (delimiters == 0) {
+            if (inputEnd - blockBase <= BLOCK_SIZE) {
+                // input ended without a trailing newline
+                if (fieldCount < maxFields) {
+                    fields[fieldCount].begin = fieldStart;
+                    fields[fieldCount].end = inputEnd;
+                }
+                fieldCount++;
+                lastEnd = inputEnd;
+                cursor = inputEnd;
+                return true;
+            }
+            blockBase += BLOCK_SIZE;
+            loadBlock();
+        }
+
+        const char* p = blockBase + lowestBit(delimiters);
+        delimiters &= delimiters - 1; // clear the bit we just consumed
+
+        if (fieldCount < maxFields) {
+            fields[fieldCount].begin = fieldStart;
+            fields[fieldCount].end = p;
+        }
+        fieldCount++;
+
+        if (*p == '\n') {
+            lastEnd = p;
+            cursor = p + 1;
+            return true;
+        }
+        fieldStart = p + 1;
+    }
+}
@@ -0,0 +1,46 @@
+#ifndef CSV_SCANNER_HPP
+#define CSV_SCANNER_HPP
+
+#include <cstdint>
+
+// Untrimmed [begin, end) bytes of one CSV field inside the scanned buffer
+struct FieldSpan {
+    const char* begin;
+    const char* end;
+};
+
+// Vectorized CSV tokenizer in the style of simdjson/simdcsv.
+// The input is processed 64 bytes at a time: comma, newline and quote bitmasks
+// are built with AVX2 or SSE2 (scalar fallback elsewhere), quoted regions are
+// masked out with a prefix-xor, and the remaining delimiter bits are walked
+// with count-trailing-zeros. Each record's field spans are produced in a single
+// pass over the bytes, and block state carries over between records.
+// Commas and newlines inside double quotes do not split fields.
+class CsvScanner {
+private:
+    const char* inputEnd;   // End of the buffer
+    const char* cursor;     // Start of the next record
+    const char* blockBase;  // Address of the current 64-byte block
+    uint64_t delimiters;    // Unconsumed comma/newline bits of the current block
+    uint64_t quoteCarry;    // All ones if the current block starts inside quotes
+    const char* lastBegin;  // Bounds of the record returned by the last nextRecord()
+    const char* lastEnd;
+
+    // Build the delimiter mask for the block at blockBase
+    void loadBlock();
+
+public:
+    CsvScanner(const char* begin, const char* end);
+
+    // Scan the next record (up to the next unquoted '\n' or the end of input).
+    // Up to maxFields field spans are written to fields; fieldCount receives the
+    // total number of fields in the record, which may be larger than maxFields.
+    // Returns false once the input is exhausted.
+    bool nextRecord(FieldSpan* fields, int maxFields, int& fieldCount);
+
+    // Bounds of the record returned by the last successful nextRecord()
+    const char* recordBegin() const { return lastBegin; }
+    const char* recordEnd() const { return lastEnd; }
+};
+
+#endif // CSV_SCANNER_HPP
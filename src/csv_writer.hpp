@@ -0,0 +1,64 @@
+#ifndef CSV_WRITER_HPP
+#define CSV_WRITER_HPP
+
+#include <string>
+#include <cstdint>
+#include "buffered_writer.hpp"
+#include "transaction.hpp"
+
+// Header line of the dataset, written first by TransactionCsvExporter
+extern const char* const CSV_HEADER;
+
+// Streams transactions into a CSV file in the dataset's layout: the header,
+// then one line per row with the 18 columns in TransactionColumn order, so the
+// file loads back through parseTransaction and the CSV loaders unchanged.
+//  - strings and category names are copied from where they are stored; a value
+//    holding a comma, quote, CR or LF, or starting or ending with whitespace,
+//    is written in double quotes with its quotes doubled (RFC 4180), which
+//    parseTransaction and the loaders undo
+//  - doubles are the shortest text that reads back to the same value
+//  - timestamps as "YYYY-MM-DDTHH:MM:SS[.ffffff]", is_fraud as True/False,
+//    and a missing (NaN) number as an empty field
+// Rows are formatted into a large buffer and written with few write() calls.
+class TransactionCsvExporter {
+private:
+    BufferedWriter out;
+
+    // Write a string field, quoted when it needs to be
+    static void text(BufferedWriter& to, const std::string& value);
+
+    // Write a double field
+    static void number(BufferedWriter& to, double value);
+
+public:
+    TransactionCsvExporter();
+
+    // Create the file and write the header; returns false if it cannot be created
+    bool open(const std::string& path);
+
+    // Append one transaction
+    void add(const Transaction& t);
+
+    // Format one row (with its newline) into another writer; several threads
+    // can format at once
+    void formatRow(BufferedWriter& to, const Transaction& t) const;
+
+    // Append rowAt(0) .. rowAt(count - 1), formatted on numThreads threads (see
+    // writeInOrder); rowAt is called from several threads at once
+    template <typename RowAt>
+    void addRows(int count, RowAt rowAt, int numThreads) {
+        writeInOrder(out, count, numThreads, [&](BufferedWriter& to, int begin, int end) {
+            for (int i = begin; i < end; ++i) {
+                formatRow(to, rowAt(i));
+            }
+        });
+    }
+
+    // Flush and close the file; returns false if a write failed
+    bool close();
+
+    // Bytes written so far
+    uint64_t bytesWritten() const;
+};
+
+#endif // CSV_WRITER_HPP
@@ -0,0 +1,109 @@
+#include "dictionary.hpp"
+#include "transaction.hpp"
+#include <cstring>
+#include <stdexcept>
+#include <algorithm>
+
+// Initial number of hash slots (always a power of two)
+static const size_t INITIAL_SLOTS = 64;
+
+// FNV-1a hash of a byte range
+static size_t hashBytes(const char* data, size_t length) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < length; ++i) {
+        hash ^= (unsigned char)data[i];
+        hash *= 1099511628211ULL;
+    }
+    return (size_t)hash;
+}
+
+// Constructor: empty dictionary with a small hash table
+StringDictionary::StringDictionary() : slots(INITIAL_SLOTS, -1) {}
+
+// Linear probing until the value or an empty slot is found
+size_t StringDictionary::findSlot(const char* data, size_t length) const {
+    size_t mask = slots.size() - 1;
+    size_t slot = hashBytes(data, length) & mask;
+    while (slots[slot] != -1) {
+        const std::string& value = values[slots[slot]];
+        if (value.size() == length && std::memcmp(value.data(), data, length) == 0) {
+            break;
+        }
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+// Rehashes every code into a table twice the size
+void StringDictionary::grow() {
+    slots.assign(slots.size() * 2, -1);
+    for (size_t code = 0; code < values.size(); ++code) {
+        slots[findSlot(values[code].data(), values[code].size())] = (int)code;
+    }
+}
+
+// Returns the code for the bytes, adding them if they are new
+CategoryCode StringDictionary::intern(const char* data, size_t length) {
+    size_t slot = findSlot(data, length);
+    if (slots[slot] != -1) {
+        return (CategoryCode)slots[slot];
+    }
+    if (values.size() > 0xFFFF) {
+        throw std::length_error("dictionary has no codes left");
+    }
+
+    int code = (int)values.size();
+    values.push_back(std::string(data, length));
+    slots[slot] = code;
+    // keep the table at most half full so probe sequences stay short
+    if (values.size() * 2 > slots.size()) {
+        grow();
+    }
+    return (CategoryCode)code;
+}
+
+CategoryCode StringDictionary::intern(const std::string& value) {
+    return intern(value.data(), value.size());
+}
+
+// Returns the code for the bytes, or -1 if they were never interned
+int StringDictionary::find(const char* data, size_t length) const {
+    return slots[findSlot(data, length)];
+}
+
+int StringDictionary::find(const std::string& value) const {
+    return find(value.data(), value.size());
+}
+
+// Returns the string behind a code
+const std::string& StringDictionary::lookup(CategoryCode code) const {
+    return values[code];
+}
+
+// Returns the number of distinct values
+int StringDictionary::size() const {
+    return (int)values.size();
+}
+
+// Orders codes by their string values and records each code's position
+std::vector<int> StringDictionary::sortedRanks() const {
+    std::vector<int> order(values.size());
+    for (size_t code = 0; code < order.size(); ++code) {
+        order[code] = (int)code;
+    }
+    const std::deque<std::string>& strings = values;
+    std::sort(order.begin(), order.end(), [&strings](int a, int b) {
+        return strings[a] < strings[b];
+    });
+    std::vector<int> rank(values.size());
+    for (size_t position = 0; position < order.size(); ++position) {
+        rank[order[position]] = (int)position;
+    }
+    return rank;
+}
+
+// One process-wide dictionary per column (only categorical columns are used)
+StringDictionary& dictionaryFor(int col) {
+    static StringDictionary dictionaries[COLUMN_COUNT];
+    return dictionaries[col];
+}
@@ -0,0 +1,50 @@
+#ifndef DICTIONARY_HPP
+#define DICTIONARY_HPP
+
+#include <string>
+#include <deque>
+#include <vector>
+#include <cstdint>
+
+// Small integer standing in for an interned categorical string
+typedef uint16_t CategoryCode;
+
+// Interns strings into dense codes 0..size()-1 in first-seen order.
+// Lookups hash the raw bytes, so interning a field straight out of the input
+// buffer does not build a temporary std::string. Not thread-safe: concurrent
+// loaders intern into private dictionaries and remap the codes afterwards.
+class StringDictionary {
+private:
+    std::deque<std::string> values; // Code -> string (deque keeps references stable)
+    std::vector<int> slots;         // Open-addressing hash table of codes (-1 = empty)
+
+    // Slot holding the code for these bytes, or the empty slot where it belongs
+    size_t findSlot(const char* data, size_t length) const;
+
+    // Double the hash table and reinsert every code
+    void grow();
+
+public:
+    StringDictionary();
+
+    // Return the code for the bytes, adding them if new.
+    // Throws std::length_error once every CategoryCode value is in use.
+    CategoryCode intern(const char* data, size_t length);
+    CategoryCode intern(const std::string& value);
+
+    // Return the code for value, or -1 if it has never been interned
+    int find(const char* data, size_t length) const;
+    int find(const std::string& value) const;
+
+    // Return the string for a code
+    const std::string& lookup(CategoryCode code) const;
+
+    // Number of distinct values
+    int size() const;
+
+    // Position of every code when the values are sorted as strings, so that
+    // rank[a] < rank[b] exactly when lookup(a) < lookup(b)
+    std::vector<int> sortedRanks() const;
+};
+
+#endif // DICTIONARY_HPP
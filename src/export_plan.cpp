@@ -0,0 +1,97 @@
+#include "export_plan.hpp"
+#include "array_store.hpp"
+#include "array_selection.hpp"
+#include "linked_list_store.hpp"
+#include <atomic>
+#include <utility>
+
+// Constructor
+ExportPlan::ExportPlan(int numThreads) {
+    threads = numThreads;
+}
+
+int ExportPlan::add(const std::string& path, const Query& query, const JsonExportOptions& options) {
+    Target target;
+    target.path = path;
+    target.query = query;
+    target.exporter.reset(new TransactionJsonExporter(options));
+    target.rows = 0;
+    targets.push_back(std::move(target));
+    return (int)targets.size() - 1;
+}
+
+size_t ExportPlan::size() const {
+    return targets.size();
+}
+
+// Every file is opened first; a chunk's rows are numbered begin .. end - 1 and
+// each query narrows that list to its own matches. Queries can throw
+// std::invalid_argument (as Query::matchingRows does), so they are checked on
+// an empty batch before any thread starts.
+template <typename RowAt>
+bool ExportPlan::run(int count, RowAt rowAt) {
+    if (targets.empty()) return true; // nothing to write
+    TransactionQuerySource<RowAt> source(rowAt);
+    for (size_t k = 0; k < targets.size(); ++k) {
+        targets[k].query.matchingRows(source, nullptr, 0);
+    }
+
+    bool ok = true;
+    std::vector<char> opened(targets.size());
+    for (size_t k = 0; k < targets.size(); ++k) {
+        opened[k] = targets[k].exporter->open(targets[k].path);
+        if (!opened[k]) ok = false;
+        targets[k].rows = 0;
+    }
+
+    int outputs = (int)targets.size();
+    std::vector<std::atomic<int> > matched(targets.size());
+    formatInOrder(count, threads, outputs, [&](BufferedWriter* const* to, int begin, int end) {
+        std::vector<int> candidates(end - begin);
+        for (int i = begin; i < end; ++i) {
+            candidates[i - begin] = i;
+        }
+        for (int k = 0; k < outputs; ++k) {
+            const Target& target = targets[k];
+            if (!opened[k]) continue;
+            std::vector<int> rows = target.query.size() == 0 ? candidates
+                : target.query.matchingRows(source, candidates.data(), (int)candidates.size());
+            for (size_t i = 0; i < rows.size(); ++i) {
+                target.exporter->formatRow(*to[k], rowAt(rows[i]), false);
+            }
+            matched[k] += (int)rows.size();
+        }
+    }, [&](BufferedWriter* const* from) {
+        for (int k = 0; k < outputs; ++k) {
+            targets[k].exporter->addFormatted(from[k]->bufferedData(), from[k]->bufferedSize());
+        }
+    });
+
+    for (size_t k = 0; k < targets.size(); ++k) {
+        targets[k].rows = matched[k];
+        if (opened[k] && !targets[k].exporter->close()) ok = false;
+    }
+    return ok;
+}
+
+bool ExportPlan::run(const ArrayStore& store) {
+    return run(store.getSize(), [&store](int i) -> const Transaction& { return store.at(i); });
+}
+
+bool ExportPlan::run(const ArraySelection& selection) {
+    return run(selection.getSize(), [&selection](int i) -> const Transaction& { return selection.at(i); });
+}
+
+// The list's nodes are collected first so the chunks can be read by position
+bool ExportPlan::run(const LinkedListStore& store) {
+    std::vector<const Transaction*> rows = store.rowPointers();
+    return run((int)rows.size(), [&rows](int i) -> const Transaction& { return *rows[i]; });
+}
+
+const std::string& ExportPlan::path(size_t target) const {
+    return targets[target].path;
+}
+
+int ExportPlan::rowsWritten(size_t target) const {
+    return targets[target].rows;
+}
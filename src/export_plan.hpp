@@ -0,0 +1,58 @@
+#ifndef EXPORT_PLAN_HPP
+#define EXPORT_PLAN_HPP
+
+#include <string>
+#include <vector>
+#include <memory>
+#include "json_writer.hpp"
+#include "query.hpp"
+
+class ArrayStore;
+class ArraySelection;
+class LinkedListStore;
+
+// Several JSON exports filled in one pass over a store. Each target is a
+// query and an output file: rows matching every predicate of the query (all
+// rows for an empty query) are written to the file. The rows are read once,
+// a chunk at a time: every target's query is run on the chunk and each
+// matching row is formatted for every target it belongs to, on worker threads
+// (see formatInOrder). Each file is the same as exporting that target alone.
+class ExportPlan {
+private:
+    struct Target {
+        std::string path;
+        Query query;
+        std::unique_ptr<TransactionJsonExporter> exporter;
+        int rows; // Rows written by the last run
+    };
+    std::vector<Target> targets;
+    int threads; // 0 = one per core
+
+    // Run every target over rowAt(0) .. rowAt(count - 1)
+    template <typename RowAt>
+    bool run(int count, RowAt rowAt);
+
+public:
+    // Constructor: numThreads formatting threads (0 = one per core)
+    explicit ExportPlan(int numThreads = 0);
+
+    // Add a target (layout and fields from options; options.threads is not
+    // used, the plan's thread count applies). Returns the target's number.
+    int add(const std::string& path, const Query& query, const JsonExportOptions& options = JsonExportOptions());
+
+    // Number of targets
+    size_t size() const;
+
+    // Write every target from one pass over the store; returns false if a
+    // file could not be written (the other files are still written). A plan
+    // without targets writes nothing and reads no rows.
+    bool run(const ArrayStore& store);
+    bool run(const ArraySelection& selection);
+    bool run(const LinkedListStore& store);
+
+    // Output file of a target and the rows written to it by the last run
+    const std::string& path(size_t target) const;
+    int rowsWritten(size_t target) const;
+};
+
+#endif // EXPORT_PLAN_HPP
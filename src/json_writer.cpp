@@ -0,0 +1,167 @@
+#include "json_writer.hpp"
+#include "timestamp.hpp"
+#include "../lib/json.hpp" // nlohmann::detail::to_chars (Grisu2 shortest doubles)
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+// Copies runs of plain bytes at once and escapes the rest like nlohmann::json
+// (", \, the short escapes, \u00XX for other control characters). Bytes from
+// 0x7F up pass through unchanged.
+void TransactionJsonExporter::string(BufferedWriter& to, const char* data, size_t length) {
+    static const char HEX[] = "0123456789abcdef";
+    to.raw("\"", 1);
+    size_t start = 0;
+    for (size_t i = 0; i < length; ++i) {
+        unsigned char c = (unsigned char)data[i];
+        if (c >= 0x20 && c != '"' && c != '\\') continue;
+        to.raw(data + start, i - start);
+        start = i + 1;
+        char escape[6] = {'\\', 0, 0, 0, 0, 0};
+        size_t n = 2;
+        switch (c) {
+            case '"': escape[1] = '"'; break;
+            case '\\': escape[1] = '\\'; break;
+            case '\b': escape[1] = 'b'; break;
+            case '\f': escape[1] = 'f'; break;
+            case '\n': escape[1] = 'n'; break;
+            case '\r': escape[1] = 'r'; break;
+            case '\t': escape[1] = 't'; break;
+            default:
+                escape[1] = 'u';
+                escape[2] = '0';
+                escape[3] = '0';
+                escape[4] = HEX[c >> 4];
+                escape[5] = HEX[c & 15];
+                n = 6;
+                break;
+        }
+        to.raw(escape, n);
+    }
+    to.raw(data + start, length - start);
+    to.raw("\"", 1);
+}
+
+// The same Grisu2 conversion nlohmann::json uses, so the digits match dump()
+void TransactionJsonExporter::number(BufferedWriter& to, double value) {
+    if (!std::isfinite(value)) {
+        to.raw("null", 4);
+        return;
+    }
+    char text[64];
+    char* end = nlohmann::detail::to_chars(text, text + sizeof(text), value);
+    to.raw(text, (size_t)(end - text));
+}
+
+// Sorts and de-duplicates the columns and prepares each field's key text
+TransactionJsonExporter::TransactionJsonExporter(const JsonExportOptions& options) {
+    layout = options.layout;
+    for (size_t i = 0; i < options.columns.size(); ++i) {
+        int col = options.columns[i];
+        if (col >= 0 && col < COLUMN_COUNT) fields.push_back(col);
+    }
+    if (options.columns.empty()) {
+        for (int col = 0; col < COLUMN_COUNT; ++col) {
+            fields.push_back(col);
+        }
+    }
+    std::sort(fields.begin(), fields.end(), [](int a, int b) {
+        return std::strcmp(columnName(a), columnName(b)) < 0;
+    });
+    fields.erase(std::unique(fields.begin(), fields.end()), fields.end());
+
+    for (size_t i = 0; i < fields.size(); ++i) {
+        std::string key = std::string("\"") + columnName(fields[i]) + "\":";
+        if (layout == JSON_PRETTY) {
+            keyText.push_back((i == 0 ? "        " : ",\n        ") + key + " ");
+        } else {
+            keyText.push_back((i == 0 ? "" : ",") + key);
+        }
+    }
+    started = false;
+}
+
+bool TransactionJsonExporter::open(const std::string& path) {
+    started = false;
+    return out.open(path);
+}
+
+void TransactionJsonExporter::value(BufferedWriter& to, const Transaction& t, int column) const {
+    switch (column) {
+        case COL_TIMESTAMP: {
+            char stamp[TIMESTAMP_TEXT_SIZE];
+            string(to, stamp, (size_t)formatTimestamp(t.timestamp, stamp));
+            break;
+        }
+        case COL_AMOUNT: number(to, t.amount); break;
+        case COL_TRANSACTION_TYPE: string(to, t.transactionTypeName()); break;
+        case COL_MERCHANT_CATEGORY: string(to, t.merchantCategoryName()); break;
+        case COL_LOCATION: string(to, t.locationName()); break;
+        case COL_DEVICE_USED: string(to, t.deviceUsedName()); break;
+        case COL_IS_FRAUD:
+            if (t.is_fraud) to.raw("true", 4);
+            else to.raw("false", 5);
+            break;
+        case COL_TIME_SINCE_LAST_TRANSACTION: number(to, t.time_since_last_transaction); break;
+        case COL_SPENDING_DEVIATION: number(to, t.spending_deviation); break;
+        case COL_VELOCITY_SCORE: to.integer(t.velocity_score); break;
+        case COL_GEO_ANOMALY: number(to, t.geo_anomaly); break;
+        case COL_PAYMENT_CHANNEL: string(to, t.paymentChannelName()); break;
+        default: string(to, t.stringValue(column)); break;
+    }
+}
+
+// Pretty: "[\n    {\n<fields>\n    }" then ",\n    {..."; compact: "[{...}" then
+// ",{...}"; lines: "{...}\n" for every row. An object without fields is "{}".
+void TransactionJsonExporter::formatRow(BufferedWriter& to, const Transaction& t, bool first) const {
+    if (layout == JSON_PRETTY) {
+        to.raw(first ? "[\n    {" : ",\n    {");
+        if (!fields.empty()) to.raw("\n", 1);
+    } else if (layout == JSON_COMPACT) {
+        to.raw(first ? "[{" : ",{");
+    } else {
+        to.raw("{", 1);
+    }
+    for (size_t i = 0; i < fields.size(); ++i) {
+        to.raw(keyText[i]);
+        value(to, t, fields[i]);
+    }
+    if (layout == JSON_PRETTY) {
+        to.raw(fields.empty() ? "}" : "\n    }");
+    } else if (layout == JSON_COMPACT) {
+        to.raw("}", 1);
+    } else {
+        to.raw("}\n", 2);
+    }
+}
+
+void TransactionJsonExporter::add(const Transaction& t) {
+    formatRow(out, t, !started);
+    started = true;
+}
+
+// Later rows start with ','; the first one of an array starts with '[' instead
+void TransactionJsonExporter::addFormatted(const char* text, size_t length) {
+    if (length == 0) return;
+    if (!started && layout != JSON_LINES) {
+        out.raw("[", 1);
+        text++;
+        length--;
+    }
+    out.raw(text, length);
+    started = true;
+}
+
+// An empty array is "[]", as dump() writes it; an empty NDJSON file is empty
+bool TransactionJsonExporter::close() {
+    if (layout == JSON_PRETTY) {
+        out.raw(started ? "\n]" : "[]");
+    } else if (layout == JSON_COMPACT) {
+        out.raw(started ? "]" : "[]");
+    }
+    return out.close();
+}
+
+uint64_t TransactionJsonExporter::bytesWritten() const {
+    return out.bytesWritten();
+}
@@ -0,0 +1,87 @@
+#ifndef JSON_WRITER_HPP
+#define JSON_WRITER_HPP
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "buffered_writer.hpp"
+#include "transaction.hpp"
+
+// How TransactionJsonExporter lays out the rows
+enum JsonLayout {
+    JSON_PRETTY,  // One array, 4-space indent (the text of dump(4))
+    JSON_COMPACT, // One array without whitespace (the text of dump())
+    JSON_LINES    // Newline-delimited JSON: one compact object per line, no array
+};
+
+// Layout and fields of a JSON export
+struct JsonExportOptions {
+    JsonLayout layout;
+    std::vector<int> columns; // TransactionColumns to write; empty means all 18
+    int threads;              // Formatting threads; 0 = one per core
+
+    JsonExportOptions() : layout(JSON_PRETTY), threads(0) {}
+};
+
+// Streams transactions into a JSON file one row at a time. With the default
+// options the file is byte-for-byte the text of toJSON().dump(4), but no JSON
+// tree is built, so memory does not grow with the rows. Fields always come in
+// the sorted key order of a nlohmann::json object; columns outside the
+// TransactionColumn range are ignored.
+class TransactionJsonExporter {
+private:
+    BufferedWriter out;
+    JsonLayout layout;
+    std::vector<int> fields;          // Columns to write, sorted by name
+    std::vector<std::string> keyText; // Separator, quoted name and colon before each field
+    bool started;                     // Whether a row has been written
+
+    // JSON values, formatted like nlohmann::json::dump: strings quoted with
+    // control characters escaped, doubles in the shortest form that reads
+    // back exactly (NaN and infinity as null)
+    static void string(BufferedWriter& to, const char* data, size_t length);
+    static void string(BufferedWriter& to, const std::string& text) { string(to, text.data(), text.size()); }
+    static void number(BufferedWriter& to, double value);
+
+    // Write the value of one column
+    void value(BufferedWriter& to, const Transaction& t, int column) const;
+
+public:
+    explicit TransactionJsonExporter(const JsonExportOptions& options = JsonExportOptions());
+
+    // Start the file; returns false if it cannot be created
+    bool open(const std::string& path);
+
+    // Append one transaction
+    void add(const Transaction& t);
+
+    // Format one row into another writer (first: the file's first row). Only
+    // reads the exporter, so several threads can format at once.
+    void formatRow(BufferedWriter& to, const Transaction& t, bool first) const;
+
+    // Append whole rows formatted elsewhere by formatRow(to, t, false); the
+    // first row of the file has its separator replaced by the opening bracket
+    void addFormatted(const char* text, size_t length);
+
+    // Append rowAt(0) .. rowAt(count - 1), formatted on numThreads threads (see
+    // writeInOrder); rowAt is called from several threads at once
+    template <typename RowAt>
+    void addRows(int count, RowAt rowAt, int numThreads) {
+        bool first = !started;
+        writeInOrder(out, count, numThreads, [&](BufferedWriter& to, int begin, int end) {
+            for (int i = begin; i < end; ++i) {
+                formatRow(to, rowAt(i), first && i == 0);
+            }
+        });
+        if (count > 0) started = true;
+    }
+
+    // Finish the file and close it; returns false if a write failed
+    bool close();
+
+    // Bytes written so far
+    uint64_t bytesWritten() const;
+};
+
+#endif // JSON_WRITER_HPP
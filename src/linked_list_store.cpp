@@ -1,81 +1,194 @@
 #include "linked_list_store.hpp"
 #include "transaction.hpp"
+#include "timestamp.hpp"
 #include <iostream>
+#include <new>
+
+// nodes in the first block; each new block doubles up to the maximum
+static const int FIRST_BLOCK_NODES = 16;
+static const int MAX_BLOCK_NODES = 4096;
+
+// pool constructor: no blocks until the first node
+NodePool::NodePool() {
+    used = 0;
+}
+
+// pool destructor: destroy the nodes and free the blocks
+NodePool::~NodePool() {
+    clear();
+}
+
+// pool move constructor: take over the blocks
+NodePool::NodePool(NodePool&& other) : blocks(std::move(other.blocks)) {
+    used = other.used;
+    other.blocks.clear();
+    other.used = 0;
+}
+
+// pool move assignment: release our blocks and take over the other's
+NodePool& NodePool::operator=(NodePool&& other) {
+    if (this != &other) {
+        clear();
+        blocks = std::move(other.blocks);
+        used = other.used;
+        other.blocks.clear();
+        other.used = 0;
+    }
+    return *this;
+}
+
+// hand out the next free slot, starting a bigger block when the last is full
+Node* NodePool::allocate() {
+    if (blocks.empty() || used == blocks.back().capacity) {
+        int capacity = blocks.empty() ? FIRST_BLOCK_NODES : blocks.back().capacity * 2;
+        if (capacity > MAX_BLOCK_NODES) capacity = MAX_BLOCK_NODES;
+        Block block;
+        block.nodes = static_cast<Node*>(::operator new(sizeof(Node) * capacity));
+        block.capacity = capacity;
+        blocks.push_back(block);
+        used = 0;
+    }
+    return &blocks.back().nodes[used++];
+}
+
+// construct a node in pooled storage
+Node* NodePool::create(const Transaction& t) {
+    Node* slot = allocate();
+    return new (slot) Node(t);
+}
+
+Node* NodePool::create(Transaction&& t) {
+    Node* slot = allocate();
+    return new (slot) Node(std::move(t));
+}
+
+// destroy every constructed node, then free each block in one call
+void NodePool::clear() {
+    for (size_t b = 0; b < blocks.size(); ++b) {
+        int count = (b + 1 == blocks.size()) ? used : blocks[b].capacity;
+        for (int i = 0; i < count; ++i) {
+            blocks[b].nodes[i].~Node();
+        }
+        ::operator delete(blocks[b].nodes);
+    }
+    blocks.clear();
+    used = 0;
+}
 
 // constructor: initialize empty linked list
 LinkedListStore::LinkedListStore() {
     head = nullptr;
+    tail = nullptr;
     size = 0;
+    accountIndexValid = false;
 }
 
-// destructor: release all memory
+// destructor: the pool releases all memory
 LinkedListStore::~LinkedListStore() {
-    deleteList(head);
 }
 
 // copy constructor: create deep copy
 LinkedListStore::LinkedListStore(const LinkedListStore& other) {
-    head = copyList(other.head);
-    size = other.size;
+    head = nullptr;
+    tail = nullptr;
+    size = 0;
+    accountIndexValid = false;
+    copyList(other.head);
 }
 
 // assignment operator: create deep copy
 LinkedListStore& LinkedListStore::operator=(const LinkedListStore& other) {
     if (this != &other) {
-        deleteList(head);
-        head = copyList(other.head);
-        size = other.size;
+        deleteList();
+        copyList(other.head);
     }
     return *this;
 }
 
-// helper method to delete all nodes
-void LinkedListStore::deleteList(Node* head) {
-    while (head != nullptr) {
-        Node* temp = head;
-        head = head->next;
-        delete temp;
+// move constructor: take over the nodes, leaving the other list empty
+LinkedListStore::LinkedListStore(LinkedListStore&& other) : nodes(std::move(other.nodes)) {
+    head = other.head;
+    tail = other.tail;
+    size = other.size;
+    // the nodes keep their addresses, so the indexes move along
+    senderIndex = std::move(other.senderIndex);
+    receiverIndex = std::move(other.receiverIndex);
+    indexedNodes = std::move(other.indexedNodes);
+    accountIndexValid = other.accountIndexValid;
+    other.head = nullptr;
+    other.tail = nullptr;
+    other.size = 0;
+    other.invalidateAccountIndexes();
+}
+
+// move assignment: release our nodes and take over the other's
+LinkedListStore& LinkedListStore::operator=(LinkedListStore&& other) {
+    if (this != &other) {
+        nodes = std::move(other.nodes);
+        head = other.head;
+        tail = other.tail;
+        size = other.size;
+        senderIndex = std::move(other.senderIndex);
+        receiverIndex = std::move(other.receiverIndex);
+        indexedNodes = std::move(other.indexedNodes);
+        accountIndexValid = other.accountIndexValid;
+        other.head = nullptr;
+        other.tail = nullptr;
+        other.size = 0;
+        other.invalidateAccountIndexes();
     }
+    return *this;
 }
 
-// helper method to create deep copy
-Node* LinkedListStore::copyList(Node* head) const {
-    if (head == nullptr) return nullptr;
-    
-    Node* newHead = new Node(head->data);
-    Node* current = newHead;
-    head = head->next;
-    
+// helper method to delete all nodes (a few block frees, no per-node delete)
+void LinkedListStore::deleteList() {
+    invalidateAccountIndexes();
+    nodes.clear();
+    head = nullptr;
+    tail = nullptr;
+    size = 0;
+}
+
+// helper method to append copies of another list's nodes
+void LinkedListStore::copyList(const Node* head) {
     while (head != nullptr) {
-        current->next = new Node(head->data);
-        current = current->next;
+        appendNode(nodes.create(head->data));
         head = head->next;
     }
-    
-    return newHead;
 }
 
-// add transaction to end of linked list
-void LinkedListStore::addTransaction(const Transaction& t) {
-    Node* newNode = new Node(t);
-    
+// helper method to link a new node after the tail
+void LinkedListStore::appendNode(Node* node) {
+    invalidateAccountIndexes();
     if (head == nullptr) {
-        head = newNode;
+        head = node;
     } else {
-        Node* current = head;
-        while (current->next != nullptr) {
-            current = current->next;
-        }
-        current->next = newNode;
+        tail->next = node;
     }
+    tail = node;
     size++;
 }
 
+// add transaction to end of linked list
+void LinkedListStore::addTransaction(const Transaction& t) {
+    appendNode(nodes.create(t));
+}
+
+// add transaction to end of linked list, moving its strings
+void LinkedListStore::addTransaction(Transaction&& t) {
+    appendNode(nodes.create(std::move(t)));
+}
+
 // return current number of transactions
 int LinkedListStore::getSize() const {
     return size;
 }
 
+// return first node for read-only traversal
+const Node* LinkedListStore::getHead() const {
+    return head;
+}
+
 // display all transactions to console
 void LinkedListStore::display() const {
     std::cout << "\n--- Transactions (Linked List) ---\n";
@@ -86,11 +199,11 @@ void LinkedListStore::display() const {
     while (current != nullptr && count < 10) {
         const Transaction& t = current->data;
         std::cout << "ID: " << t.transaction_id
-                  << ", Date: " << t.timestamp
+                  << ", Date: " << formatTimestamp(t.timestamp)
                   << ", Amount: " << t.amount
-                  << ", Type: " << t.transaction_type
-                  << ", Location: " << t.location
-                  << ", Channel: " << t.payment_channel
+                  << ", Type: " << t.transactionTypeName()
+                  << ", Location: " << t.locationName()
+                  << ", Channel: " << t.paymentChannelName()
                   << std::endl;
         current = current->next;
         count++;
@@ -112,11 +225,11 @@ void LinkedListStore::display() const {
             while (current != nullptr) {
                 const Transaction& t = current->data;
                 std::cout << "ID: " << t.transaction_id
-                          << ", Date: " << t.timestamp
+                          << ", Date: " << formatTimestamp(t.timestamp)
                           << ", Amount: " << t.amount
-                          << ", Type: " << t.transaction_type
-                          << ", Location: " << t.location
-                          << ", Channel: " << t.payment_channel
+                          << ", Type: " << t.transactionTypeName()
+                          << ", Location: " << t.locationName()
+                          << ", Channel: " << t.paymentChannelName()
                           << std::endl;
                 current = current->next;
                 count++;
@@ -134,9 +247,11 @@ void LinkedListStore::display() const {
 LinkedListStore LinkedListStore::groupByPaymentChannel(const std::string& channel) const {
     LinkedListStore grouped;
     Node* current = head;
+    // compare dictionary codes instead of strings (an unknown channel matches nothing)
+    int code = dictionaryFor(COL_PAYMENT_CHANNEL).find(channel);
     
     while (current != nullptr) {
-        if (current->data.payment_channel == channel) {
+        if (current->data.payment_channel == code) {
             grouped.addTransaction(current->data);
         }
         current = current->next;
@@ -145,13 +260,48 @@ LinkedListStore LinkedListStore::groupByPaymentChannel(const std::string& channe
     return grouped;
 }
 
+// partition by a categorical column: one traversal, each node is copied to
+// the list of its code
+std::vector<LinkedListStore> LinkedListStore::partitionBy(int column) const {
+    std::vector<LinkedListStore> groups;
+    if (columnType(column) != TYPE_CATEGORY) return groups;
+    groups.resize(dictionaryFor(column).size());
+    
+    for (Node* current = head; current != nullptr; current = current->next) {
+        groups[current->data.categoryValue(column)].addTransaction(current->data);
+    }
+    
+    return groups;
+}
+
+// query the list: number the nodes once so batches can address rows by position
+LinkedListStore LinkedListStore::where(const Query& query) const {
+    std::vector<const Node*> nodeAt;
+    nodeAt.reserve(size);
+    for (const Node* current = head; current != nullptr; current = current->next) {
+        nodeAt.push_back(current);
+    }
+    const Node* const* nodeRows = nodeAt.data();
+    auto rowAt = [nodeRows](int r) -> const Transaction& { return nodeRows[r]->data; };
+    TransactionQuerySource<decltype(rowAt)> source(rowAt);
+    
+    LinkedListStore found;
+    std::vector<int> rows = query.matchingRows(source, nullptr, size);
+    for (size_t i = 0; i < rows.size(); ++i) {
+        found.addTransaction(nodeAt[rows[i]]->data);
+    }
+    return found;
+}
+
 // search for transactions by type
 LinkedListStore LinkedListStore::searchByTransactionType(const std::string& type) const {
     LinkedListStore found;
     Node* current = head;
+    // compare dictionary codes instead of strings (an unknown type matches nothing)
+    int code = dictionaryFor(COL_TRANSACTION_TYPE).find(type);
     
     while (current != nullptr) {
-        if (current->data.transaction_type == type) {
+        if (current->data.transaction_type == code) {
             found.addTransaction(current->data);
         }
         current = current->next;
@@ -160,62 +310,183 @@ LinkedListStore LinkedListStore::searchByTransactionType(const std::string& type
     return found;
 }
 
-// helper method to find middle of linked list
-Node* LinkedListStore::getMiddle(Node* head) {
-    if (head == nullptr || head->next == nullptr) {
-        return head;
+// merge two sorted runs by relinking their nodes (left wins ties, so runs
+// built from earlier nodes must be passed as left to keep the sort stable)
+static Node* mergeRuns(Node* left, Node* right, const std::vector<int>& rank) {
+    Node* merged = nullptr;
+    Node** link = &merged; // where the next node is attached
+    while (left != nullptr && right != nullptr) {
+        if (rank[left->data.location] <= rank[right->data.location]) {
+            *link = left;
+            left = left->next;
+        } else {
+            *link = right;
+            right = right->next;
+        }
+        link = &(*link)->next;
     }
+    *link = (left != nullptr) ? left : right;
+    return merged;
+}
+
+// bottom-up merge sort without recursion: bins[i] holds a sorted run of 2^i
+// nodes, and each node taken from the list is carried up through the bins
+// like a binary counter. Small runs are merged while they are still in cache,
+// and the only extra memory is the fixed array of 64 run heads.
+void LinkedListStore::mergeSort(const std::vector<int>& rank) {
+    const int BIN_COUNT = 64;
+    Node* bins[BIN_COUNT] = {nullptr};
     
-    Node* slow = head;
-    Node* fast = head->next;
+    Node* rest = head;
+    while (rest != nullptr) {
+        Node* run = rest;
+        rest = rest->next;
+        run->next = nullptr;
+        
+        // bins hold earlier nodes than run, so they go on the left
+        int i = 0;
+        while (i < BIN_COUNT - 1 && bins[i] != nullptr) {
+            run = mergeRuns(bins[i], run, rank);
+            bins[i] = nullptr;
+            i++;
+        }
+        bins[i] = mergeRuns(bins[i], run, rank);
+    }
     
-    while (fast != nullptr && fast->next != nullptr) {
-        slow = slow->next;
-        fast = fast->next->next;
+    // higher bins hold earlier nodes: merge from the bottom up
+    Node* sorted = nullptr;
+    for (int i = 0; i < BIN_COUNT; ++i) {
+        if (bins[i] != nullptr) {
+            sorted = mergeRuns(bins[i], sorted, rank);
+        }
     }
     
-    return slow;
+    head = sorted;
+    tail = sorted;
+    while (tail->next != nullptr) {
+        tail = tail->next;
+    }
 }
 
-// helper method to merge two sorted linked lists
-Node* LinkedListStore::merge(Node* left, Node* right) {
-    if (left == nullptr) return right;
-    if (right == nullptr) return left;
-    
-    Node* result = nullptr;
+// counting sort: append every node to the bucket of its location rank (a
+// single pass that keeps equal locations in order), then chain the buckets
+void LinkedListStore::countingSort(const std::vector<int>& rank) {
+    std::vector<Node*> bucketHead(rank.size(), nullptr);
+    std::vector<Node*> bucketTail(rank.size(), nullptr);
     
-    if (left->data.location <= right->data.location) {
-        result = left;
-        result->next = merge(left->next, right);
-    } else {
-        result = right;
-        result->next = merge(left, right->next);
+    for (Node* current = head; current != nullptr; current = current->next) {
+        int r = rank[current->data.location];
+        if (bucketTail[r] == nullptr) {
+            bucketHead[r] = current;
+        } else {
+            bucketTail[r]->next = current;
+        }
+        bucketTail[r] = current;
     }
     
-    return result;
+    head = nullptr;
+    tail = nullptr;
+    for (size_t r = 0; r < rank.size(); ++r) {
+        if (bucketHead[r] == nullptr) continue;
+        if (tail == nullptr) {
+            head = bucketHead[r];
+        } else {
+            tail->next = bucketHead[r];
+        }
+        tail = bucketTail[r];
+    }
+    tail->next = nullptr;
 }
 
-// recursive merge sort for linked list
-Node* LinkedListStore::mergeSort(Node* head) {
-    if (head == nullptr || head->next == nullptr) {
-        return head;
+// sort transactions by location with the chosen strategy
+void LinkedListStore::sortByLocation(SortStrategy strategy) {
+    if (size > 1) {
+        invalidateAccountIndexes();
+        // compare the alphabetical rank of each location code, not the strings
+        std::vector<int> rank = dictionaryFor(COL_LOCATION).sortedRanks();
+        if (strategy == SORT_COUNTING) {
+            countingSort(rank);
+        } else {
+            mergeSort(rank);
+        }
     }
+}
+
+// sort by normalized keys: number the nodes in list order, sort the numbers
+// with one memcmp per comparison, then relink the nodes in that order
+void LinkedListStore::sortBy(const std::vector<SortKey>& keys) {
+    if (size <= 1) return;
+    invalidateAccountIndexes();
     
-    Node* middle = getMiddle(head);
-    Node* nextOfMiddle = middle->next;
-    middle->next = nullptr;
-    
-    Node* left = mergeSort(head);
-    Node* right = mergeSort(nextOfMiddle);
+    std::vector<Node*> nodeAt;
+    nodeAt.reserve(size);
+    SortKeyTable table(keys);
+    for (Node* current = head; current != nullptr; current = current->next) {
+        nodeAt.push_back(current);
+        table.fitRow(current->data);
+    }
+    table.allocate(size);
+    for (int i = 0; i < size; ++i) {
+        table.putRow(i, nodeAt[i]->data);
+    }
     
-    return merge(left, right);
+    std::vector<int> order = table.sortedOrder();
+    head = nodeAt[order[0]];
+    for (int i = 1; i < size; ++i) {
+        nodeAt[order[i - 1]]->next = nodeAt[order[i]];
+    }
+    tail = nodeAt[order[size - 1]];
+    tail->next = nullptr;
 }
 
-// sort transactions by location using merge sort
-void LinkedListStore::sortByLocation() {
-    if (size > 1) {
-        head = mergeSort(head);
+// drop the account indexes so the next lookup rebuilds them
+void LinkedListStore::invalidateAccountIndexes() {
+    if (accountIndexValid) {
+        senderIndex.clear();
+        receiverIndex.clear();
+        indexedNodes.clear();
+        accountIndexValid = false;
+    }
+}
+
+// number the nodes in list order once, then index both account columns
+void LinkedListStore::buildAccountIndexes() const {
+    if (accountIndexValid) return;
+    indexedNodes.clear();
+    indexedNodes.reserve(size);
+    for (const Node* current = head; current != nullptr; current = current->next) {
+        indexedNodes.push_back(current);
     }
+    const std::vector<const Node*>& nodeAt = indexedNodes;
+    senderIndex.build(size, [&nodeAt](int i) -> const std::string& { return nodeAt[i]->data.sender_account; });
+    receiverIndex.build(size, [&nodeAt](int i) -> const std::string& { return nodeAt[i]->data.receiver_account; });
+    accountIndexValid = true;
+}
+
+// copy the nodes at the account's positions into a new list
+LinkedListStore LinkedListStore::copyIndexed(const AccountIndex& index, const std::string& account) const {
+    LinkedListStore found;
+    int count;
+    const int* positions = index.find(account, count);
+    for (int i = 0; i < count; ++i) {
+        found.addTransaction(indexedNodes[positions[i]]->data);
+    }
+    return found;
+}
+
+LinkedListStore LinkedListStore::bySenderAccount(const std::string& account) const {
+    buildAccountIndexes();
+    return copyIndexed(senderIndex, account);
+}
+
+LinkedListStore LinkedListStore::byReceiverAccount(const std::string& account) const {
+    buildAccountIndexes();
+    return copyIndexed(receiverIndex, account);
+}
+
+size_t LinkedListStore::accountIndexBytes() const {
+    if (!accountIndexValid) return 0;
+    return senderIndex.byteSize() + receiverIndex.byteSize() + indexedNodes.capacity() * sizeof(const Node*);
 }
 
 // export transactions to json format
@@ -227,21 +498,21 @@ nlohmann::json LinkedListStore::toJSON() const {
         const Transaction& t = current->data;
         nlohmann::json j_trans = {
             {"transaction_id", t.transaction_id},
-            {"timestamp", t.timestamp},
+            {"timestamp", formatTimestamp(t.timestamp)},
             {"sender_account", t.sender_account},
             {"receiver_account", t.receiver_account},
             {"amount", t.amount},
-            {"transaction_type", t.transaction_type},
-            {"merchant_category", t.merchant_category},
-            {"location", t.location},
-            {"device_used", t.device_used},
+            {"transaction_type", t.transactionTypeName()},
+            {"merchant_category", t.merchantCategoryName()},
+            {"location", t.locationName()},
+            {"device_used", t.deviceUsedName()},
             {"is_fraud", t.is_fraud},
             {"fraud_type", t.fraud_type},
             {"time_since_last_transaction", t.time_since_last_transaction},
             {"spending_deviation", t.spending_deviation},
             {"velocity_score", t.velocity_score},
             {"geo_anomaly", t.geo_anomaly},
-            {"payment_channel", t.payment_channel},
+            {"payment_channel", t.paymentChannelName()},
             {"ip_address", t.ip_address},
             {"device_hash", t.device_hash}
         };
@@ -252,14 +523,42 @@ nlohmann::json LinkedListStore::toJSON() const {
     return j_array;
 }
 
+// stream transactions to a json file
+bool LinkedListStore::exportJSON(const std::string& path, const JsonExportOptions& options) const {
+    TransactionJsonExporter exporter(options);
+    if (!exporter.open(path)) return false;
+    // collect the nodes first so worker threads can index the rows
+    std::vector<const Transaction*> rows = rowPointers();
+    exporter.addRows((int)rows.size(), [&rows](int i) -> const Transaction& { return *rows[i]; }, options.threads);
+    return exporter.close();
+}
+
+// write transactions to a csv file
+bool LinkedListStore::exportCSV(const std::string& path, int numThreads) const {
+    TransactionCsvExporter exporter;
+    if (!exporter.open(path)) return false;
+    std::vector<const Transaction*> rows = rowPointers();
+    exporter.addRows((int)rows.size(), [&rows](int i) -> const Transaction& { return *rows[i]; }, numThreads);
+    return exporter.close();
+}
+
+// collect a pointer to every node's transaction, in list order
+std::vector<const Transaction*> LinkedListStore::rowPointers() const {
+    std::vector<const Transaction*> rows;
+    rows.reserve(size);
+    for (Node* current = head; current != nullptr; current = current->next) {
+        rows.push_back(&current->data);
+    }
+    return rows;
+}
+
 // get all fraudulent transactions
 LinkedListStore LinkedListStore::getFraudulentTransactions() const {
     LinkedListStore fraudulent;
     Node* current = head;
     while (current != nullptr) {
-        std::string fraudValue = current->data.is_fraud;
-        // check for true/false values (case-insensitive)
-        if (toLower(fraudValue) == "true") {
+        // is_fraud is parsed to a bool at load time
+        if (current->data.is_fraud) {
             fraudulent.addTransaction(current->data);
         }
         current = current->next;
@@ -2,8 +2,15 @@
 #define LINKED_LIST_STORE_HPP
 
 #include <string>
+#include <vector>
+#include <utility>
 #include "../lib/json.hpp" // For JSON export
+#include "json_writer.hpp"
+#include "csv_writer.hpp"
 #include "transaction.hpp" // Use shared Transaction struct and utilities
+#include "sort_key.hpp"
+#include "account_index.hpp"
+#include "query.hpp"
 
 // Node structure for the linked list
 struct Node {
@@ -11,13 +18,57 @@ struct Node {
     Node* next;
     
     Node(const Transaction& t) : data(t), next(nullptr) {}
+    Node(Transaction&& t) : data(std::move(t)), next(nullptr) {}
+};
+
+// Allocates nodes from large contiguous blocks instead of one new per node, so
+// neighbouring nodes sit next to each other in memory. Nodes are never freed
+// one at a time: clear() destroys every node handed out and frees the blocks.
+class NodePool {
+private:
+    struct Block {
+        Node* nodes;  // Raw storage for capacity nodes
+        int capacity;
+    };
+    std::vector<Block> blocks;
+    int used; // Nodes handed out from the last block (earlier blocks are full)
+
+    // Storage for one more node, starting a new block when the last one is full
+    Node* allocate();
+
+public:
+    NodePool();
+    ~NodePool();
+
+    // Not copyable (nodes belong to one list), but movable
+    NodePool(const NodePool&) = delete;
+    NodePool& operator=(const NodePool&) = delete;
+    NodePool(NodePool&& other);
+    NodePool& operator=(NodePool&& other);
+
+    // Construct a node holding t
+    Node* create(const Transaction& t);
+    Node* create(Transaction&& t);
+
+    // Destroy every node and release all blocks
+    void clear();
 };
 
 // Linked list-based class to store and manage transactions
 class LinkedListStore {
 private:
-    Node* head;  // Pointer to the first node
-    int size;    // Number of transactions
+    Node* head;     // Pointer to the first node
+    Node* tail;     // Pointer to the last node (appends are O(1))
+    int size;       // Number of transactions
+    NodePool nodes; // Owns the storage of every node in the list
+
+    // Account indexes: list positions of each sender_account and
+    // receiver_account, with the node at every position. Built on demand and
+    // dropped when nodes are added or relinked.
+    mutable AccountIndex senderIndex;
+    mutable AccountIndex receiverIndex;
+    mutable std::vector<const Node*> indexedNodes;
+    mutable bool accountIndexValid;
 
 public:
     // Constructor and destructor
@@ -28,14 +79,33 @@ public:
     LinkedListStore(const LinkedListStore& other);
     LinkedListStore& operator=(const LinkedListStore& other);
 
-    // Add a transaction to the linked list
+    // Move constructor and assignment operator (take over the nodes)
+    LinkedListStore(LinkedListStore&& other);
+    LinkedListStore& operator=(LinkedListStore&& other);
+
+    // Add a transaction to the end of the linked list
     void addTransaction(const Transaction& t);
+    void addTransaction(Transaction&& t);
 
     // Group transactions by payment channel (returns a new LinkedListStore)
     LinkedListStore groupByPaymentChannel(const std::string& channel) const;
 
-    // Sort transactions by location (ascending) using merge sort
-    void sortByLocation();
+    // Sort transactions by location (ascending, stable) by relinking nodes in
+    // place: an iterative bottom-up merge sort, or a counting sort that
+    // distributes the nodes into one bucket per location
+    void sortByLocation(SortStrategy strategy = SORT_MERGE);
+
+    // Sort by several columns, each ascending or descending (stable); the
+    // nodes are relinked in the sorted order
+    void sortBy(const std::vector<SortKey>& keys);
+
+    // Split the list by a categorical column in one traversal: list c holds
+    // the transactions whose code is c (dictionaryFor(column).lookup(c) is its
+    // value). Returns no lists for a column that is not TYPE_CATEGORY.
+    std::vector<LinkedListStore> partitionBy(int column) const;
+
+    // Transactions matching every predicate of query (returns a new LinkedListStore)
+    LinkedListStore where(const Query& query) const;
 
     // Search for transactions by type (returns a new LinkedListStore)
     LinkedListStore searchByTransactionType(const std::string& type) const;
@@ -43,22 +113,48 @@ public:
     // Export transactions to JSON
     nlohmann::json toJSON() const;
 
+    // Stream the list to a JSON file, same text as toJSON().dump(4); false on a write error
+    bool exportJSON(const std::string& path, const JsonExportOptions& options = JsonExportOptions()) const;
+
+    // Write the list to a CSV file in the dataset's layout; false on a write error
+    bool exportCSV(const std::string& path, int numThreads = 0) const;
+
+    // Pointers to the transactions in list order (valid until the list changes)
+    std::vector<const Transaction*> rowPointers() const;
+
     // Display transactions to console
     void display() const;
 
     // Get the number of transactions
     int getSize() const;
 
+    // Get the first node, for read-only traversal (nullptr when empty)
+    const Node* getHead() const;
+
     // Get fraudulent transactions
     LinkedListStore getFraudulentTransactions() const;
 
+    // Build the sender and receiver account indexes now (otherwise they are
+    // built by the first account lookup)
+    void buildAccountIndexes() const;
+
+    // Transactions sent or received by account, in list order (returns a new
+    // LinkedListStore; O(k) for k matches once the indexes are built)
+    LinkedListStore bySenderAccount(const std::string& account) const;
+    LinkedListStore byReceiverAccount(const std::string& account) const;
+
+    // Estimated memory held by the account indexes (0 when not built)
+    size_t accountIndexBytes() const;
+
 private:
-    // Helper methods for merge sort
-    Node* mergeSort(Node* head);
-    Node* merge(Node* left, Node* right);
-    Node* getMiddle(Node* head);
-    Node* copyList(Node* head) const;
-    void deleteList(Node* head);
+    // Helper methods
+    void mergeSort(const std::vector<int>& rank);
+    void countingSort(const std::vector<int>& rank);
+    void appendNode(Node* node);
+    void copyList(const Node* head);
+    void deleteList();
+    void invalidateAccountIndexes();
+    LinkedListStore copyIndexed(const AccountIndex& index, const std::string& account) const;
 };
 
 #endif // LINKED_LIST_STORE_HPP 
\ No newline at end of file
@@ -1,6 +1,14 @@
 #include "array_store.hpp"
 #include "linked_list_store.hpp"
 #include "transaction.hpp"
+#include "csv_loader.hpp"
+#include "view_store.hpp"
+#include "column_store.hpp"
+#include "numeric_parse.hpp"
+#include "timestamp.hpp"
+#include "bitmap_index.hpp"
+#include "query.hpp"
+#include "export_plan.hpp"
 #include <iostream>
 #include <fstream>
 #include <sstream>
@@ -8,57 +16,123 @@
 #include <cctype>
 #include <map>
 #include <vector>
+#include <chrono>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+#include <algorithm>
+
+// location of the dataset, relative to the working directory
+const std::string DATA_PATH = "data/financial_fraud_detection_dataset.csv";
+
+// binary columnar snapshot written by menu option 12 and read by ingestion method 4
+const std::string SNAPSHOT_PATH = "output/transactions.snapshot";
+
+// parse a numeric csv field, throwing like std::stod when it is not a number
+double parseNumericField(const std::string& field) {
+    double value;
+    if (!parseDouble(field.data(), field.data() + field.size(), value)) {
+        throw std::invalid_argument("not a number: " + field);
+    }
+    return value;
+}
+
+// read the csv field starting at pos into field and move pos past its comma;
+// commas and newlines inside double quotes do not end a field, and a quoted
+// value loses its quotes (see unquoteSpan). Returns false at the end of line.
+bool nextCsvField(const std::string& line, size_t& pos, std::string& field) {
+    if (pos >= line.size()) return false;
+    size_t end = pos;
+    bool inQuotes = false;
+    for (; end < line.size(); ++end) {
+        if (line[end] == '"') inQuotes = !inQuotes;
+        else if (line[end] == ',' && !inQuotes) break;
+    }
+    const char* begin = line.data() + pos;
+    const char* stop = line.data() + end;
+    unquoteSpan(begin, stop);
+    field.clear();
+    appendUnquoted(field, begin, stop);
+    pos = end < line.size() ? end + 1 : end;
+    return true;
+}
+
+// read one csv record, which continues onto the next lines while a quoted
+// value is still open (a quoted newline)
+bool getCsvRecord(std::istream& in, std::string& record) {
+    if (!getline(in, record)) return false;
+    std::string more;
+    while (std::count(record.begin(), record.end(), '"') % 2 != 0 && getline(in, more)) {
+        record += '\n';
+        record += more;
+    }
+    return true;
+}
 
 // parse csv line into transaction object
 Transaction parseTransaction(const std::string& line) {
-    std::stringstream ss(line);
+    size_t pos = 0;
     std::string field;
     Transaction t;
     int col = 0;
 
-    // initialize string fields
+    // initialize string fields (categorical columns are dictionary codes and the
+    // timestamp and numeric columns are parsed below; an empty
+    // time_since_last_transaction is NaN)
     t.transaction_id = "";
-    t.timestamp = "";
     t.sender_account = "";
     t.receiver_account = "";
-    t.transaction_type = "";
-    t.merchant_category = "";
-    t.location = "";
-    t.device_used = "";
-    t.is_fraud = "";
     t.fraud_type = "";
-    t.time_since_last_transaction = "";
-    t.spending_deviation = "";
-    t.velocity_score = "";
-    t.geo_anomaly = "";
-    t.payment_channel = "";
     t.ip_address = "";
     t.device_hash = "";
 
-    while (getline(ss, field, ',')) {
-        field = trim(field);
+    while (nextCsvField(line, pos, field)) {
         switch (col) {
             case 0: t.transaction_id = field; break;
-            case 1: t.timestamp = field; break;
+            case 1:
+                if (!parseTimestamp(field.data(), field.data() + field.size(), t.timestamp)) {
+                    throw std::invalid_argument("timestamp is not YYYY-MM-DDTHH:MM:SS: " + field);
+                }
+                break;
             case 2: t.sender_account = field; break;
             case 3: t.receiver_account = field; break;
-            case 4: t.amount = std::stod(field); break;
-            case 5: t.transaction_type = field; break;
-            case 6: t.merchant_category = field; break;
-            case 7: t.location = field; break;
-            case 8: t.device_used = field; break;
-            case 9: t.is_fraud = field; break;
+            case 4: t.amount = parseNumericField(field); break;
+            case 5: t.transaction_type = dictionaryFor(COL_TRANSACTION_TYPE).intern(field); break;
+            case 6: t.merchant_category = dictionaryFor(COL_MERCHANT_CATEGORY).intern(field); break;
+            case 7: t.location = dictionaryFor(COL_LOCATION).intern(field); break;
+            case 8: t.device_used = dictionaryFor(COL_DEVICE_USED).intern(field); break;
+            case 9:
+                if (!parseBool(field.data(), field.data() + field.size(), t.is_fraud)) {
+                    throw std::invalid_argument("is_fraud is not true/false: " + field);
+                }
+                break;
             case 10: t.fraud_type = field; break;
-            case 11: t.time_since_last_transaction = field; break;
-            case 12: t.spending_deviation = field; break;
-            case 13: t.velocity_score = field; break;
-            case 14: t.geo_anomaly = field; break;
-            case 15: t.payment_channel = field; break;
+            case 11:
+                t.time_since_last_transaction = field.empty() ? std::numeric_limits<double>::quiet_NaN()
+                                                              : parseNumericField(field);
+                break;
+            case 12: t.spending_deviation = parseNumericField(field); break;
+            case 13:
+                if (!parseInt(field.data(), field.data() + field.size(), t.velocity_score)) {
+                    throw std::invalid_argument("velocity_score is not an integer: " + field);
+                }
+                break;
+            case 14: t.geo_anomaly = parseNumericField(field); break;
+            case 15: t.payment_channel = dictionaryFor(COL_PAYMENT_CHANNEL).intern(field); break;
             case 16: t.ip_address = field; break;
             case 17: t.device_hash = field; break;
         }
         col++;
     }
+    
+    // categorical columns missing from a short row decode to ""
+    if (col <= 5) t.transaction_type = dictionaryFor(COL_TRANSACTION_TYPE).intern("");
+    if (col <= 6) t.merchant_category = dictionaryFor(COL_MERCHANT_CATEGORY).intern("");
+    if (col <= 7) t.location = dictionaryFor(COL_LOCATION).intern("");
+    if (col <= 8) t.device_used = dictionaryFor(COL_DEVICE_USED).intern("");
+    if (col <= 15) t.payment_channel = dictionaryFor(COL_PAYMENT_CHANNEL).intern("");
+    // the timestamp and typed numeric columns are required
+    if (col <= 14) throw std::invalid_argument("row is missing numeric columns");
     return t;
 }
 
@@ -66,26 +140,27 @@ Transaction parseTransaction(const std::string& line) {
 void demonstratePaymentChannelGrouping(const ArrayStore& arrayStore, const LinkedListStore& linkedListStore) {
     std::cout << "\n=== FUNCTION 1: GROUPING BY PAYMENT CHANNEL ===\n";
     
-    std::vector<std::string> channels = {"card", "wire_transfer", "mobile_payment", "online_banking"};
+    // one pass finds every channel in the data, not just a fixed list
+    const StringDictionary& channels = dictionaryFor(COL_PAYMENT_CHANNEL);
     
     std::cout << "\n--- Array Implementation ---\n";
-    for (const std::string& channel : channels) {
-        ArrayStore channelStore = arrayStore.groupByPaymentChannel(channel);
-        std::cout << "Channel '" << channel << "': " << channelStore.getSize() << " transactions\n";
-        if (channelStore.getSize() > 0) {
-            std::cout << "Sample transactions:\n";
-            channelStore.display();
-        }
+    std::vector<ArraySelection> arrayGroups = arrayStore.partitionBy(COL_PAYMENT_CHANNEL);
+    for (size_t code = 0; code < arrayGroups.size(); ++code) {
+        const ArraySelection& channelStore = arrayGroups[code];
+        if (channelStore.getSize() == 0) continue;
+        std::cout << "Channel '" << channels.lookup(code) << "': " << channelStore.getSize() << " transactions\n";
+        std::cout << "Sample transactions:\n";
+        channelStore.display();
     }
     
     std::cout << "\n--- Linked List Implementation ---\n";
-    for (const std::string& channel : channels) {
-        LinkedListStore channelStore = linkedListStore.groupByPaymentChannel(channel);
-        std::cout << "Channel '" << channel << "': " << channelStore.getSize() << " transactions\n";
-        if (channelStore.getSize() > 0) {
-            std::cout << "Sample transactions:\n";
-            channelStore.display();
-        }
+    std::vector<LinkedListStore> listGroups = linkedListStore.partitionBy(COL_PAYMENT_CHANNEL);
+    for (size_t code = 0; code < listGroups.size(); ++code) {
+        const LinkedListStore& channelStore = listGroups[code];
+        if (channelStore.getSize() == 0) continue;
+        std::cout << "Channel '" << channels.lookup(code) << "': " << channelStore.getSize() << " transactions\n";
+        std::cout << "Sample transactions:\n";
+        channelStore.display();
     }
 }
 
@@ -93,23 +168,29 @@ void demonstratePaymentChannelGrouping(const ArrayStore& arrayStore, const Linke
 void demonstrateLocationSorting(ArrayStore& arrayStore, LinkedListStore& linkedListStore) {
     std::cout << "\n=== FUNCTION 2: SORTING BY LOCATION ===\n";
     
+    int strategyChoice;
+    std::cout << "Sort strategy (1 = merge sort, 2 = counting sort on location codes): ";
+    std::cin >> strategyChoice;
+    SortStrategy strategy = (strategyChoice == 2) ? SORT_COUNTING : SORT_MERGE;
+    const char* strategyName = (strategy == SORT_COUNTING) ? "Counting Sort" : "Merge Sort";
+    
     // create copies for sorting demonstration
     ArrayStore arrayCopy = arrayStore;
     LinkedListStore linkedListCopy = linkedListStore;
     
-    std::cout << "\n--- Array Implementation (Merge Sort) ---\n";
+    std::cout << "\n--- Array Implementation (" << strategyName << ") ---\n";
     std::cout << "Before sorting:\n";
     arrayCopy.display();
     
-    arrayCopy.sortByLocation();
+    arrayCopy.sortByLocation(strategy);
     std::cout << "After sorting by location:\n";
     arrayCopy.display();
     
-    std::cout << "\n--- Linked List Implementation (Merge Sort) ---\n";
+    std::cout << "\n--- Linked List Implementation (" << strategyName << ") ---\n";
     std::cout << "Before sorting:\n";
     linkedListCopy.display();
     
-    linkedListCopy.sortByLocation();
+    linkedListCopy.sortByLocation(strategy);
     std::cout << "After sorting by location:\n";
     linkedListCopy.display();
 }
@@ -122,7 +203,7 @@ void demonstrateTransactionTypeSearch(const ArrayStore& arrayStore, const Linked
     
     std::cout << "\n--- Array Implementation (Linear Search) ---\n";
     for (const std::string& type : transactionTypes) {
-        ArrayStore typeStore = arrayStore.searchByTransactionType(type);
+        ArraySelection typeStore = arrayStore.searchByTransactionType(type);
         std::cout << "Transaction type '" << type << "': " << typeStore.getSize() << " transactions\n";
         if (typeStore.getSize() > 0) {
             std::cout << "Sample transactions:\n";
@@ -141,56 +222,66 @@ void demonstrateTransactionTypeSearch(const ArrayStore& arrayStore, const Linked
     }
 }
 
+// size of a file in MB (0 if it cannot be read)
+double fileMegabytes(const std::string& path) {
+    std::ifstream file(path.c_str(), std::ios::binary | std::ios::ate);
+    return file ? (double)file.tellg() / (1024.0 * 1024.0) : 0.0;
+}
+
+// write one json export and report its size and speed
+template <typename Store>
+void exportJSONFile(const Store& store, const std::string& description, const std::string& path,
+                    const JsonExportOptions& options = JsonExportOptions()) {
+    auto start = std::chrono::high_resolution_clock::now();
+    bool ok = store.exportJSON(path, options);
+    auto end = std::chrono::high_resolution_clock::now();
+    if (!ok) {
+        std::cout << "Error: could not write " << path << "\n";
+        return;
+    }
+    double seconds = std::chrono::duration<double>(end - start).count();
+    double mb = fileMegabytes(path);
+    std::cout << "Exported " << store.getSize() << " " << description << " to " << path
+              << " (" << mb << " MB in " << seconds * 1000.0 << " ms";
+    if (seconds > 0.0) std::cout << ", " << mb / seconds << " MB/s";
+    std::cout << ")\n";
+}
+
+// write the withdrawal, card and all-transaction exports of a store in one pass
+// (suffix names the store in the file names)
+template <typename Store>
+void exportStandardJSONFiles(const Store& store, const std::string& suffix) {
+    static const char* const DESCRIPTIONS[] = {"withdrawal transactions", "card transactions", "all transactions"};
+    ExportPlan plan;
+    plan.add("output/withdrawal_transactions_" + suffix + ".json", Query().where(COL_TRANSACTION_TYPE, PRED_EQUAL, "withdrawal"));
+    plan.add("output/card_transactions_" + suffix + ".json", Query().where(COL_PAYMENT_CHANNEL, PRED_EQUAL, "card"));
+    plan.add("output/all_transactions_" + suffix + ".json", Query());
+    
+    auto start = std::chrono::high_resolution_clock::now();
+    bool ok = plan.run(store);
+    double seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+    
+    double mb = 0.0;
+    for (size_t k = 0; k < plan.size(); ++k) {
+        std::cout << "Exported " << plan.rowsWritten(k) << " " << DESCRIPTIONS[k] << " to " << plan.path(k) << "\n";
+        mb += fileMegabytes(plan.path(k));
+    }
+    if (!ok) std::cout << "Error: not every file could be written\n";
+    std::cout << "One pass over " << store.getSize() << " rows, " << plan.size() << " files: " << mb << " MB in "
+              << seconds * 1000.0 << " ms";
+    if (seconds > 0.0) std::cout << " (" << mb / seconds << " MB/s)";
+    std::cout << "\n";
+}
+
 // generate json exports
 void demonstrateJSONGeneration(const ArrayStore& arrayStore, const LinkedListStore& linkedListStore) {
     std::cout << "\n=== FUNCTION 4: JSON GENERATION ===\n";
     
-    // generate json for withdrawal transactions
     std::cout << "\n--- Array Implementation JSON Export ---\n";
-    ArrayStore withdrawalArray = arrayStore.searchByTransactionType("withdrawal");
-    nlohmann::json arrayJson = withdrawalArray.toJSON();
-    std::ofstream arrayJsonFile("output/withdrawal_transactions_array.json");
-    arrayJsonFile << arrayJson.dump(4);
-    arrayJsonFile.close();
-    std::cout << "Exported " << withdrawalArray.getSize() << " withdrawal transactions to output/withdrawal_transactions_array.json\n";
-    
-    // generate json for card transactions
-    ArrayStore cardArray = arrayStore.groupByPaymentChannel("card");
-    nlohmann::json cardArrayJson = cardArray.toJSON();
-    std::ofstream cardArrayJsonFile("output/card_transactions_array.json");
-    cardArrayJsonFile << cardArrayJson.dump(4);
-    cardArrayJsonFile.close();
-    std::cout << "Exported " << cardArray.getSize() << " card transactions to output/card_transactions_array.json\n";
-    
-    // generate json for all transactions
-    nlohmann::json allArrayJson = arrayStore.toJSON();
-    std::ofstream allArrayJsonFile("output/all_transactions_array.json");
-    allArrayJsonFile << allArrayJson.dump(4);
-    allArrayJsonFile.close();
-    std::cout << "Exported " << arrayStore.getSize() << " all transactions to output/all_transactions_array.json\n";
+    exportStandardJSONFiles(arrayStore, "array");
     
     std::cout << "\n--- Linked List Implementation JSON Export ---\n";
-    LinkedListStore withdrawalLinkedList = linkedListStore.searchByTransactionType("withdrawal");
-    nlohmann::json linkedListJson = withdrawalLinkedList.toJSON();
-    std::ofstream linkedListJsonFile("output/withdrawal_transactions_linkedlist.json");
-    linkedListJsonFile << linkedListJson.dump(4);
-    linkedListJsonFile.close();
-    std::cout << "Exported " << withdrawalLinkedList.getSize() << " withdrawal transactions to output/withdrawal_transactions_linkedlist.json\n";
-    
-    // generate json for card transactions
-    LinkedListStore cardLinkedList = linkedListStore.groupByPaymentChannel("card");
-    nlohmann::json cardLinkedListJson = cardLinkedList.toJSON();
-    std::ofstream cardLinkedListJsonFile("output/card_transactions_linkedlist.json");
-    cardLinkedListJsonFile << cardLinkedListJson.dump(4);
-    cardLinkedListJsonFile.close();
-    std::cout << "Exported " << cardLinkedList.getSize() << " card transactions to output/card_transactions_linkedlist.json\n";
-    
-    // generate json for all transactions
-    nlohmann::json allLinkedListJson = linkedListStore.toJSON();
-    std::ofstream allLinkedListJsonFile("output/all_transactions_linkedlist.json");
-    allLinkedListJsonFile << allLinkedListJson.dump(4);
-    allLinkedListJsonFile.close();
-    std::cout << "Exported " << linkedListStore.getSize() << " all transactions to output/all_transactions_linkedlist.json\n";
+    exportStandardJSONFiles(linkedListStore, "linkedlist");
 }
 
 // detect fraudulent transactions
@@ -200,7 +291,7 @@ void demonstrateFraudDetection(const ArrayStore& arrayStore, const LinkedListSto
     // debug fraud values
     arrayStore.debugFraudValues();
     
-    ArrayStore fraudArray = arrayStore.getFraudulentTransactions();
+    ArraySelection fraudArray = arrayStore.getFraudulentTransactions();
     LinkedListStore fraudLinkedList = linkedListStore.getFraudulentTransactions();
     
     std::cout << "\n--- Array Implementation ---\n";
@@ -239,7 +330,7 @@ void demonstrateAllFunctions(ArrayStore& arrayStore, LinkedListStore& linkedList
 void checkCSVHeader() {
     std::cout << "\n=== FUNCTION 7: CSV HEADER CHECK ===\n";
     
-    std::ifstream file("data/financial_fraud_detection_dataset.csv");
+    std::ifstream file(DATA_PATH);
     if (!file) {
         std::cerr << "Could not open CSV file!" << std::endl;
         return;
@@ -272,7 +363,7 @@ void showFraudStatistics(const ArrayStore& arrayStore, const LinkedListStore& li
     std::cout << "\n=== FUNCTION 8: FRAUD STATISTICS ===\n";
     
     int totalTransactions = arrayStore.getSize();
-    ArrayStore fraudArray = arrayStore.getFraudulentTransactions();
+    ArraySelection fraudArray = arrayStore.getFraudulentTransactions();
     int fraudCount = fraudArray.getSize();
     
     std::cout << "Total transactions loaded: " << totalTransactions << "\n";
@@ -283,7 +374,17 @@ void showFraudStatistics(const ArrayStore& arrayStore, const LinkedListStore& li
         double fraudPercentage = (double)fraudCount / totalTransactions * 100.0;
         std::cout << "Fraud rate: " << fraudPercentage << "%\n";
     }
-    
+
+    // chained filters narrow each channel's selection without copying any rows
+    std::cout << "\n--- Fraudulent transactions by payment channel ---\n";
+    std::vector<ArraySelection> channels = arrayStore.partitionBy(COL_PAYMENT_CHANNEL);
+    for (size_t code = 0; code < channels.size(); ++code) {
+        if (channels[code].getSize() == 0) continue;
+        ArraySelection channelFraud = channels[code].getFraudulentTransactions();
+        std::cout << dictionaryFor(COL_PAYMENT_CHANNEL).lookup(code) << ": " << channelFraud.getSize()
+                  << " (withdrawals: " << channelFraud.searchByTransactionType("withdrawal").getSize() << ")\n";
+    }
+
     std::cout << "\n--- Sample of fraudulent transactions ---\n";
     if (fraudCount > 0) {
         fraudArray.display();
@@ -292,6 +393,657 @@ void showFraudStatistics(const ArrayStore& arrayStore, const LinkedListStore& li
     }
 }
 
+// load zero-copy views and compare them with the owning array store
+void demonstrateZeroCopyViews(const ArrayStore& arrayStore) {
+    std::cout << "\n=== FUNCTION 9: ZERO-COPY VIEWS ===\n";
+    
+    // load the same number of rows as the owning stores hold
+    ViewStore viewStore(arrayStore.getSize());
+    LoadStats stats;
+    if (!loadTransactionViews(DATA_PATH, arrayStore.getSize(), viewStore, stats)) {
+        std::cerr << "Could not map CSV file! Please ensure '" << DATA_PATH << "' exists.\n";
+        return;
+    }
+    std::cout << "Loaded " << stats.rows << " views in " << stats.seconds << " s ("
+              << (long long)stats.rowsPerSecond() << " rows/sec)\n";
+    std::cout << "Row size: " << sizeof(TransactionView) << " bytes per view vs "
+              << sizeof(Transaction) << " bytes per Transaction (plus its string allocations)\n";
+    
+    // the same filters, run without materializing any strings
+    ViewStore withdrawals = viewStore.searchByTransactionType("withdrawal");
+    ViewStore card = viewStore.groupByPaymentChannel("card");
+    ViewStore fraud = viewStore.getFraudulentTransactions();
+    std::cout << "\n--- Views vs Array Implementation ---\n";
+    std::cout << "Withdrawals: " << withdrawals.getSize() << " (array: "
+              << arrayStore.searchByTransactionType("withdrawal").getSize() << ")\n";
+    std::cout << "Card: " << card.getSize() << " (array: "
+              << arrayStore.groupByPaymentChannel("card").getSize() << ")\n";
+    std::cout << "Fraudulent: " << fraud.getSize() << " (array: "
+              << arrayStore.getFraudulentTransactions().getSize() << ")\n";
+    
+    if (fraud.getSize() > 0) {
+        std::cout << "Sample fraudulent transactions:\n";
+        fraud.display();
+    }
+}
+
+// seconds elapsed since start
+double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// build a columnar copy of the data and time the same scans on both layouts
+void demonstrateColumnStore(const ArrayStore& arrayStore) {
+    std::cout << "\n=== FUNCTION 10: COLUMNAR STORE ===\n";
+    
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    ColumnStore columnStore(arrayStore.getSize());
+    for (int i = 0; i < arrayStore.getSize(); ++i) {
+        columnStore.addTransaction(arrayStore.at(i));
+    }
+    std::cout << "Built column store with " << columnStore.getSize() << " rows in "
+              << secondsSince(start) << " s\n";
+    
+    std::cout << "\n--- Scan times: Array vs Columnar ---\n";
+    
+    start = std::chrono::steady_clock::now();
+    int arrayCard = arrayStore.groupByPaymentChannel("card").getSize();
+    double arrayTime = secondsSince(start);
+    start = std::chrono::steady_clock::now();
+    int columnCard = columnStore.groupByPaymentChannel("card").getSize();
+    double columnTime = secondsSince(start);
+    std::cout << "Group by channel 'card': " << arrayCard << " rows in " << arrayTime << " s (array), "
+              << columnCard << " rows in " << columnTime << " s (columnar)\n";
+    
+    start = std::chrono::steady_clock::now();
+    int arrayWithdrawal = arrayStore.searchByTransactionType("withdrawal").getSize();
+    arrayTime = secondsSince(start);
+    start = std::chrono::steady_clock::now();
+    int columnWithdrawal = columnStore.searchByTransactionType("withdrawal").getSize();
+    columnTime = secondsSince(start);
+    std::cout << "Search type 'withdrawal': " << arrayWithdrawal << " rows in " << arrayTime << " s (array), "
+              << columnWithdrawal << " rows in " << columnTime << " s (columnar)\n";
+    
+    start = std::chrono::steady_clock::now();
+    int arrayFraud = arrayStore.getFraudulentTransactions().getSize();
+    arrayTime = secondsSince(start);
+    start = std::chrono::steady_clock::now();
+    int columnFraud = columnStore.getFraudulentTransactions().getSize();
+    columnTime = secondsSince(start);
+    std::cout << "Fraudulent: " << arrayFraud << " rows in " << arrayTime << " s (array), "
+              << columnFraud << " rows in " << columnTime << " s (columnar)\n";
+    
+    ArrayStore arrayCopy = arrayStore;
+    start = std::chrono::steady_clock::now();
+    arrayCopy.sortByLocation();
+    arrayTime = secondsSince(start);
+    start = std::chrono::steady_clock::now();
+    columnStore.sortByLocation();
+    columnTime = secondsSince(start);
+    std::cout << "Sort by location: " << arrayTime << " s (array), " << columnTime << " s (columnar)\n";
+    
+    std::cout << "\nSorted columnar store:\n";
+    columnStore.display();
+}
+
+// parse a date ("YYYY-MM-DD", taken as the start or end of that day) or a full
+// "YYYY-MM-DDTHH:MM:SS[.ffffff]" timestamp typed by the user
+bool parseTimeArgument(const std::string& text, bool endOfDay, int64_t& micros) {
+    std::string full = text;
+    if (full.size() == 10) {
+        full += endOfDay ? "T23:59:59.999999" : "T00:00:00";
+    }
+    return parseTimestamp(full.data(), full.data() + full.size(), micros);
+}
+
+// answer a time-range query with the sorted time index and with a full scan
+void demonstrateTimeRangeQuery(const ArrayStore& arrayStore) {
+    std::cout << "\n=== FUNCTION 11: TIME RANGE QUERY ===\n";
+    
+    std::string fromText, toText;
+    int64_t from, to;
+    std::cout << "Enter start (YYYY-MM-DD or YYYY-MM-DDTHH:MM:SS): ";
+    std::cin >> fromText;
+    std::cout << "Enter end (YYYY-MM-DD or YYYY-MM-DDTHH:MM:SS): ";
+    std::cin >> toText;
+    if (!parseTimeArgument(fromText, false, from) || !parseTimeArgument(toText, true, to)) {
+        std::cout << "Invalid date or time!\n";
+        return;
+    }
+    std::cout << "Range: " << formatTimestamp(from) << " to " << formatTimestamp(to) << "\n";
+    
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    arrayStore.buildTimeIndex();
+    std::cout << "Built time index over " << arrayStore.getSize() << " rows in "
+              << secondsSince(start) << " s\n";
+    
+    start = std::chrono::steady_clock::now();
+    int indexCount = arrayStore.countByTime(from, to);
+    double indexTime = secondsSince(start);
+    
+    start = std::chrono::steady_clock::now();
+    int scanCount = 0;
+    for (int i = 0; i < arrayStore.getSize(); ++i) {
+        int64_t t = arrayStore.at(i).timestamp;
+        if (t >= from && t <= to) scanCount++;
+    }
+    double scanTime = secondsSince(start);
+    
+    std::cout << "Binary search: " << indexCount << " transactions in " << indexTime << " s\n";
+    std::cout << "Full scan: " << scanCount << " transactions in " << scanTime << " s\n";
+    
+    ArrayStore inRange = arrayStore.rangeByTime(from, to);
+    if (inRange.getSize() > 0) {
+        std::cout << "Sample transactions (in time order):\n";
+        inRange.display();
+    }
+}
+
+// write the loaded transactions to a binary snapshot for fast restarts
+void saveSnapshot(const ArrayStore& arrayStore) {
+    std::cout << "\n=== FUNCTION 12: SAVE BINARY SNAPSHOT ===\n";
+    
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    ColumnStore columnStore(arrayStore.getSize());
+    for (int i = 0; i < arrayStore.getSize(); ++i) {
+        columnStore.addTransaction(arrayStore.at(i));
+    }
+    if (!columnStore.saveSnapshot(SNAPSHOT_PATH)) {
+        std::cerr << "Could not write snapshot to " << SNAPSHOT_PATH << "\n";
+        return;
+    }
+    std::cout << "Saved " << columnStore.getSize() << " transactions to " << SNAPSHOT_PATH
+              << " in " << secondsSince(start) << " s\n";
+    std::cout << "Choose ingestion method 4 on the next run to load it without parsing the CSV.\n";
+}
+
+// time the linked list merge sort on a large list (rows are repeated when
+// more nodes are requested than were loaded)
+void benchmarkLinkedListSort(const ArrayStore& arrayStore) {
+    std::cout << "\n=== FUNCTION 13: LINKED LIST SORT BENCHMARK ===\n";
+    if (arrayStore.getSize() == 0) {
+        std::cout << "No transactions loaded!\n";
+        return;
+    }
+    
+    int nodeCount;
+    std::cout << "Number of nodes to sort (0 = " << arrayStore.getSize() << " loaded rows, 5000000 = full dataset size): ";
+    std::cin >> nodeCount;
+    if (nodeCount <= 0) nodeCount = arrayStore.getSize();
+    
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    LinkedListStore list;
+    for (int i = 0; i < nodeCount; ++i) {
+        list.addTransaction(arrayStore.at(i % arrayStore.getSize()));
+    }
+    std::cout << "Built list of " << list.getSize() << " nodes in " << secondsSince(start) << " s\n";
+    
+    start = std::chrono::steady_clock::now();
+    list.sortByLocation();
+    double sortTime = secondsSince(start);
+    std::cout << "Bottom-up merge sort: " << sortTime << " s ("
+              << (long long)(sortTime > 0.0 ? list.getSize() / sortTime : 0.0) << " nodes/sec)\n";
+    
+    // check the result: locations never decrease and no node was lost
+    int visited = 0;
+    bool ordered = true;
+    const Node* previous = nullptr;
+    for (const Node* node = list.getHead(); node != nullptr; node = node->next) {
+        if (previous != nullptr && node->data.locationName() < previous->data.locationName()) {
+            ordered = false;
+        }
+        previous = node;
+        visited++;
+    }
+    std::cout << "Result: " << visited << " nodes, " << (ordered ? "sorted by location" : "NOT SORTED") << "\n";
+}
+
+// compare merge sort and counting sort on copies of both stores
+void benchmarkSortStrategies(const ArrayStore& arrayStore, const LinkedListStore& linkedListStore) {
+    std::cout << "\n=== FUNCTION 14: SORT STRATEGY BENCHMARK ===\n";
+    std::cout << "Sorting " << arrayStore.getSize() << " transactions by location ("
+              << dictionaryFor(COL_LOCATION).size() << " distinct locations)\n";
+    
+    std::cout << "\n--- Array Implementation ---\n";
+    ArrayStore arrayMerge = arrayStore;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    arrayMerge.sortByLocation(SORT_MERGE);
+    std::cout << "Merge sort: " << secondsSince(start) << " s\n";
+    
+    ArrayStore arrayCounting = arrayStore;
+    start = std::chrono::steady_clock::now();
+    arrayCounting.sortByLocation(SORT_COUNTING);
+    std::cout << "Counting sort: " << secondsSince(start) << " s\n";
+    
+    start = std::chrono::steady_clock::now();
+    std::vector<int> mergeOrder = arrayStore.sortedOrderByLocation(SORT_MERGE);
+    std::cout << "Merge sort (order only): " << secondsSince(start) << " s\n";
+    start = std::chrono::steady_clock::now();
+    std::vector<int> countingOrder = arrayStore.sortedOrderByLocation(SORT_COUNTING);
+    std::cout << "Counting sort (order only): " << secondsSince(start) << " s\n";
+    std::cout << "Same order: " << (mergeOrder == countingOrder ? "yes" : "NO") << "\n";
+    
+    std::cout << "\n--- Linked List Implementation ---\n";
+    LinkedListStore listMerge = linkedListStore;
+    start = std::chrono::steady_clock::now();
+    listMerge.sortByLocation(SORT_MERGE);
+    std::cout << "Merge sort: " << secondsSince(start) << " s\n";
+    
+    LinkedListStore listCounting = linkedListStore;
+    start = std::chrono::steady_clock::now();
+    listCounting.sortByLocation(SORT_COUNTING);
+    std::cout << "Counting sort: " << secondsSince(start) << " s\n";
+    
+    // walk both results side by side
+    bool same = true;
+    const Node* a = listMerge.getHead();
+    const Node* b = listCounting.getHead();
+    while (a != nullptr && b != nullptr) {
+        if (a->data.transaction_id != b->data.transaction_id) same = false;
+        a = a->next;
+        b = b->next;
+    }
+    std::cout << "Same order: " << (same && a == nullptr && b == nullptr ? "yes" : "NO") << "\n";
+}
+
+// sort a copy of the array by any column on several threads
+void demonstrateParallelSort(const ArrayStore& arrayStore) {
+    std::cout << "\n=== FUNCTION 15: PARALLEL SORT BY COLUMN ===\n";
+    for (int col = 0; col < COLUMN_COUNT; ++col) {
+        std::cout << col << ". " << columnName(col) << "\n";
+    }
+    int column, threads;
+    std::cout << "Sort by column (0-" << COLUMN_COUNT - 1 << "): ";
+    std::cin >> column;
+    if (column < 0 || column >= COLUMN_COUNT) {
+        std::cout << "Invalid column!\n";
+        return;
+    }
+    std::cout << "Number of threads (0 = all cores): ";
+    std::cin >> threads;
+    
+    ArrayStore sorted = arrayStore;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    sorted.parallelSort(column, threads);
+    std::cout << "Parallel sort by " << columnName(column) << ": " << secondsSince(start) << " s\n";
+    
+    if (column == COL_LOCATION) {
+        ArrayStore reference = arrayStore;
+        start = std::chrono::steady_clock::now();
+        reference.sortByLocation();
+        std::cout << "sortByLocation: " << secondsSince(start) << " s\n";
+        bool same = true;
+        for (int i = 0; i < sorted.getSize(); ++i) {
+            if (sorted.at(i).transaction_id != reference.at(i).transaction_id) same = false;
+        }
+        std::cout << "Same order as sortByLocation: " << (same ? "yes" : "NO") << "\n";
+    }
+    sorted.display();
+}
+
+// sort copies of all three stores by several columns and check they agree
+void demonstrateMultiKeySort(const ArrayStore& arrayStore, const LinkedListStore& linkedListStore) {
+    std::cout << "\n=== FUNCTION 16: MULTI-KEY SORT ===\n";
+    for (int col = 0; col < COLUMN_COUNT; ++col) {
+        std::cout << col << ". " << columnName(col) << "\n";
+    }
+    int count;
+    std::cout << "Number of sort keys: ";
+    std::cin >> count;
+    if (count < 1 || count > COLUMN_COUNT) {
+        std::cout << "Invalid number of keys!\n";
+        return;
+    }
+    std::vector<SortKey> keys;
+    for (int k = 0; k < count; ++k) {
+        SortKey key;
+        char direction;
+        std::cout << "Key " << k + 1 << " column (0-" << COLUMN_COUNT - 1 << "): ";
+        std::cin >> key.column;
+        if (key.column < 0 || key.column >= COLUMN_COUNT) {
+            std::cout << "Invalid column!\n";
+            return;
+        }
+        std::cout << "Key " << k + 1 << " direction (a = ascending, d = descending): ";
+        std::cin >> direction;
+        key.descending = (direction == 'd' || direction == 'D');
+        keys.push_back(key);
+    }
+    
+    ArrayStore sortedArray = arrayStore;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    sortedArray.sortBy(keys);
+    std::cout << "Array: " << secondsSince(start) << " s\n";
+    
+    LinkedListStore sortedList = linkedListStore;
+    start = std::chrono::steady_clock::now();
+    sortedList.sortBy(keys);
+    std::cout << "Linked list: " << secondsSince(start) << " s\n";
+    
+    ColumnStore sortedColumns(arrayStore.getSize());
+    for (int i = 0; i < arrayStore.getSize(); ++i) {
+        sortedColumns.addTransaction(arrayStore.at(i));
+    }
+    start = std::chrono::steady_clock::now();
+    sortedColumns.sortBy(keys);
+    std::cout << "Columnar: " << secondsSince(start) << " s\n";
+    
+    // all three must give the same (stable) order
+    bool same = true;
+    const Node* node = sortedList.getHead();
+    for (int i = 0; i < sortedArray.getSize(); ++i) {
+        const std::string& id = sortedArray.at(i).transaction_id;
+        if (node == nullptr || node->data.transaction_id != id
+            || sortedColumns.getTransaction(i).transaction_id != id) {
+            same = false;
+            break;
+        }
+        node = node->next;
+    }
+    std::cout << "Same order in all stores: " << (same ? "yes" : "NO") << "\n";
+    sortedArray.display();
+}
+
+// read one filter value for the bitmap query ("*" means any value)
+std::string readFilterValue(const std::string& prompt) {
+    std::string value;
+    std::cout << prompt << " (* = any): ";
+    std::cin >> value;
+    return value;
+}
+
+// answer a compound filter with word-wise bitmap operations and check it against a row scan
+void demonstrateBitmapIndex(const ArrayStore& arrayStore) {
+    std::cout << "\n=== FUNCTION 17: BITMAP INDEX QUERY ===\n";
+    
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    BitmapIndex index(arrayStore);
+    std::cout << "Built bitmap index over " << arrayStore.getSize() << " rows in " << secondsSince(start)
+              << " s (" << index.byteSize() / 1024 << " KB)\n";
+    
+    std::string type = readFilterValue("Transaction type");
+    std::string channel = readFilterValue("Payment channel");
+    std::string location = readFilterValue("Location");
+    std::string excludedDevice = readFilterValue("Exclude device");
+    std::string fraudOnly;
+    std::cout << "Fraudulent only? (y/n): ";
+    std::cin >> fraudOnly;
+    
+    // type AND channel AND location AND NOT device AND fraud
+    start = std::chrono::steady_clock::now();
+    Bitmap matches = index.all();
+    if (type != "*") matches &= index.equals(COL_TRANSACTION_TYPE, type);
+    if (channel != "*") matches &= index.equals(COL_PAYMENT_CHANNEL, channel);
+    if (location != "*") matches &= index.equals(COL_LOCATION, location);
+    if (excludedDevice != "*") matches.andNot(index.equals(COL_DEVICE_USED, excludedDevice));
+    if (fraudOnly == "y" || fraudOnly == "Y") matches &= index.fraud();
+    size_t count = matches.count();
+    std::cout << "Bitmap query: " << count << " rows in " << secondsSince(start) << " s\n";
+    
+    // the same filter as a scan over every row
+    start = std::chrono::steady_clock::now();
+    std::vector<int> scanned;
+    for (int i = 0; i < arrayStore.getSize(); ++i) {
+        const Transaction& t = arrayStore.at(i);
+        if ((type == "*" || t.transactionTypeName() == type)
+            && (channel == "*" || t.paymentChannelName() == channel)
+            && (location == "*" || t.locationName() == location)
+            && (excludedDevice == "*" || t.deviceUsedName() != excludedDevice)
+            && (!(fraudOnly == "y" || fraudOnly == "Y") || t.is_fraud)) {
+            scanned.push_back(i);
+        }
+    }
+    std::cout << "Row scan: " << scanned.size() << " rows in " << secondsSince(start) << " s\n";
+    
+    ArraySelection selected = index.select(matches);
+    std::cout << "Same rows: " << (selected.getRows() == scanned ? "yes" : "NO") << "\n";
+    if (selected.getSize() > 0) {
+        selected.display();
+    }
+}
+
+// look up one account's history through the account indexes and by a full scan
+void demonstrateAccountLookup(const ArrayStore& arrayStore, const LinkedListStore& linkedListStore) {
+    std::cout << "\n=== FUNCTION 18: ACCOUNT HISTORY LOOKUP ===\n";
+    if (arrayStore.getSize() > 0) {
+        std::cout << "Example account: " << arrayStore.at(0).sender_account << "\n";
+    }
+    std::string account;
+    std::cout << "Enter account: ";
+    std::cin >> account;
+    
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    ArraySelection sent = arrayStore.bySenderAccount(account);
+    ArraySelection received = arrayStore.byReceiverAccount(account);
+    double indexTime = secondsSince(start);
+    std::cout << "\n--- Array Implementation ---\n";
+    std::cout << "Indexed lookup: " << sent.getSize() << " sent, " << received.getSize() << " received in "
+              << indexTime << " s\n";
+    
+    // the same question without the index
+    start = std::chrono::steady_clock::now();
+    int sentScan = 0, receivedScan = 0;
+    for (int i = 0; i < arrayStore.getSize(); ++i) {
+        if (arrayStore.at(i).sender_account == account) sentScan++;
+        if (arrayStore.at(i).receiver_account == account) receivedScan++;
+    }
+    std::cout << "Linear scan: " << sentScan << " sent, " << receivedScan << " received in "
+              << secondsSince(start) << " s\n";
+    
+    std::cout << "\n--- Linked List Implementation ---\n";
+    start = std::chrono::steady_clock::now();
+    LinkedListStore listSent = linkedListStore.bySenderAccount(account);
+    LinkedListStore listReceived = linkedListStore.byReceiverAccount(account);
+    std::cout << "Indexed lookup: " << listSent.getSize() << " sent, " << listReceived.getSize() << " received in "
+              << secondsSince(start) << " s\n";
+    
+    if (sent.getSize() > 0) {
+        std::cout << "\nSent transactions:";
+        sent.display();
+    }
+    if (received.getSize() > 0) {
+        std::cout << "\nReceived transactions:";
+        received.display();
+    }
+}
+
+// parse "<column> <op> <value...>" into a predicate (op: = != < > between in prefix;
+// in takes a comma-separated list, between two values)
+bool parsePredicateLine(const std::string& line, Predicate& predicate) {
+    std::stringstream ss(line);
+    std::string name, op, value;
+    if (!(ss >> name >> op)) return false;
+    
+    predicate.column = -1;
+    for (int col = 0; col < COLUMN_COUNT; ++col) {
+        if (name == columnName(col)) predicate.column = col;
+    }
+    if (predicate.column < 0) return false;
+    
+    if (op == "=") predicate.op = PRED_EQUAL;
+    else if (op == "!=") predicate.op = PRED_NOT_EQUAL;
+    else if (op == "<") predicate.op = PRED_LESS;
+    else if (op == ">") predicate.op = PRED_GREATER;
+    else if (op == "between") predicate.op = PRED_BETWEEN;
+    else if (op == "in") predicate.op = PRED_IN;
+    else if (op == "prefix") predicate.op = PRED_PREFIX;
+    else return false;
+    
+    predicate.values.clear();
+    while (ss >> value) {
+        if (predicate.op == PRED_IN) {
+            std::stringstream list(value);
+            std::string item;
+            while (getline(list, item, ',')) {
+                if (!item.empty()) predicate.values.push_back(item);
+            }
+        } else {
+            predicate.values.push_back(value);
+        }
+    }
+    return !predicate.values.empty();
+}
+
+// run an ad-hoc predicate query on all three stores
+void demonstrateQueryEngine(const ArrayStore& arrayStore, const LinkedListStore& linkedListStore) {
+    std::cout << "\n=== FUNCTION 19: AD-HOC QUERY ===\n";
+    std::cout << "Enter one predicate per line as <column> <op> <value>, then an empty line to run.\n";
+    std::cout << "Operators: = != < > between (two values) in (a,b,c) prefix\n";
+    std::cout << "Example: amount between 100 5000 / location in Tokyo,London / is_fraud = true\n";
+    
+    Query query;
+    std::string line;
+    std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+    while (std::getline(std::cin, line) && !trim(line).empty()) {
+        Predicate predicate;
+        if (parsePredicateLine(line, predicate)) {
+            query.where(predicate);
+        } else {
+            std::cout << "Could not parse '" << line << "', skipped\n";
+        }
+    }
+    std::cout << "Running " << query.size() << " predicates\n";
+    
+    try {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        ArraySelection arrayMatches = arrayStore.where(query);
+        std::cout << "Array: " << arrayMatches.getSize() << " rows in " << secondsSince(start) << " s\n";
+        
+        start = std::chrono::steady_clock::now();
+        LinkedListStore listMatches = linkedListStore.where(query);
+        std::cout << "Linked list: " << listMatches.getSize() << " rows in " << secondsSince(start) << " s\n";
+        
+        ColumnStore columnStore(arrayStore.getSize());
+        for (int i = 0; i < arrayStore.getSize(); ++i) {
+            columnStore.addTransaction(arrayStore.at(i));
+        }
+        start = std::chrono::steady_clock::now();
+        ColumnStore columnMatches = columnStore.where(query);
+        std::cout << "Columnar: " << columnMatches.getSize() << " rows in " << secondsSince(start) << " s\n";
+        
+        if (arrayMatches.getSize() > 0) {
+            arrayMatches.display();
+        }
+    } catch (const std::invalid_argument& e) {
+        std::cout << "Invalid query: " << e.what() << "\n";
+    }
+}
+
+// export all transactions as pretty, compact and newline-delimited json with a chosen set of fields
+void demonstrateExportFormats(const ArrayStore& arrayStore) {
+    std::cout << "\n=== FUNCTION 20: EXPORT FORMATS ===\n";
+    std::cout << "Fields to export, comma-separated (e.g. transaction_id,amount,is_fraud; empty for all): ";
+    
+    JsonExportOptions options;
+    std::string line, name;
+    std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+    std::getline(std::cin, line);
+    std::stringstream list(line);
+    while (getline(list, name, ',')) {
+        name = trim(name);
+        if (name.empty()) continue;
+        int column = -1;
+        for (int col = 0; col < COLUMN_COUNT; ++col) {
+            if (name == columnName(col)) column = col;
+        }
+        if (column < 0) {
+            std::cout << "Unknown field '" << name << "', skipped\n";
+        } else {
+            options.columns.push_back(column);
+        }
+    }
+    if (!trim(line).empty() && options.columns.empty()) {
+        std::cout << "No known fields given, nothing exported\n";
+        return;
+    }
+    
+    options.layout = JSON_PRETTY;
+    exportJSONFile(arrayStore, "transactions (pretty)", "output/transactions_export.json", options);
+    options.layout = JSON_COMPACT;
+    exportJSONFile(arrayStore, "transactions (compact)", "output/transactions_export_compact.json", options);
+    options.layout = JSON_LINES;
+    exportJSONFile(arrayStore, "transactions (NDJSON)", "output/transactions_export.ndjson", options);
+    
+    // the exports above format on every core; the file is the same on one thread
+    std::cout << "\n--- Pretty export on 1 thread vs " << std::max(1u, std::thread::hardware_concurrency()) << " ---\n";
+    options.layout = JSON_PRETTY;
+    options.threads = 1;
+    exportJSONFile(arrayStore, "transactions (1 thread)", "output/transactions_export.json", options);
+    options.threads = 0;
+    exportJSONFile(arrayStore, "transactions (all cores)", "output/transactions_export.json", options);
+}
+
+// write one csv export and report its size and speed
+template <typename Store>
+void exportCSVFile(const Store& store, const std::string& description, const std::string& path) {
+    auto start = std::chrono::high_resolution_clock::now();
+    bool ok = store.exportCSV(path);
+    double seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+    if (!ok) {
+        std::cout << "Error: could not write " << path << "\n";
+        return;
+    }
+    double mb = fileMegabytes(path);
+    std::cout << "Exported " << store.getSize() << " " << description << " to " << path
+              << " (" << mb << " MB in " << seconds * 1000.0 << " ms";
+    if (seconds > 0.0) std::cout << ", " << mb / seconds << " MB/s";
+    std::cout << ")\n";
+}
+
+// export csv files and read rows back with the csv parsers
+void demonstrateCSVExport(const ArrayStore& arrayStore, const LinkedListStore& linkedListStore) {
+    std::cout << "\n=== FUNCTION 21: CSV EXPORT ===\n";
+    
+    exportCSVFile(arrayStore, "all transactions", "output/all_transactions_array.csv");
+    exportCSVFile(linkedListStore, "all transactions", "output/all_transactions_linkedlist.csv");
+    ArraySelection fraudArray = arrayStore.getFraudulentTransactions();
+    exportCSVFile(fraudArray, "fraudulent transactions", "output/fraud_transactions_array.csv");
+    
+    // round trip: the first data line must parse back to the first transaction
+    std::ifstream file("output/all_transactions_array.csv");
+    std::string line;
+    if (arrayStore.getSize() > 0 && getCsvRecord(file, line) && getCsvRecord(file, line)) {
+        try {
+            Transaction t = parseTransaction(line);
+            const Transaction& original = arrayStore.at(0);
+            bool same = t.transaction_id == original.transaction_id && t.timestamp == original.timestamp
+                && t.amount == original.amount && t.is_fraud == original.is_fraud
+                && t.spending_deviation == original.spending_deviation;
+            std::cout << "Round trip of " << t.transaction_id << " through parseTransaction: "
+                      << (same ? "identical" : "DIFFERENT") << "\n";
+        } catch (const std::invalid_argument& e) {
+            std::cout << "Round trip failed: " << e.what() << "\n";
+        }
+    }
+    
+    // a row whose text needs quotes (commas, quotes, a newline, edge spaces)
+    // must come back unchanged through both CSV parsers
+    if (arrayStore.getSize() > 0) {
+        Transaction quoted = arrayStore.at(0);
+        quoted.transaction_id = "T,\"1\"";
+        quoted.fraud_type = "\"quoted\", with\r\na newline";
+        quoted.device_hash = " padded ";
+        TransactionCsvExporter exporter;
+        BufferedWriter row;
+        exporter.formatRow(row, quoted);
+        std::string record(row.bufferedData(), row.bufferedSize());
+        
+        Transaction fromBytes;
+        bool bytesSame = parseTransactionBytes(record.data(), record.data() + record.size(), fromBytes)
+            && fromBytes.transaction_id == quoted.transaction_id && fromBytes.fraud_type == quoted.fraud_type
+            && fromBytes.device_hash == quoted.device_hash && fromBytes.amount == quoted.amount;
+        bool stringSame = false;
+        try {
+            Transaction fromString = parseTransaction(record);
+            stringSame = fromString.transaction_id == quoted.transaction_id && fromString.fraud_type == quoted.fraud_type
+                && fromString.device_hash == quoted.device_hash && fromString.amount == quoted.amount;
+        } catch (const std::invalid_argument&) {
+        }
+        std::cout << "Round trip of a quoted row: parseTransaction " << (stringSame ? "identical" : "DIFFERENT")
+                  << ", parseTransactionBytes " << (bytesSame ? "identical" : "DIFFERENT") << "\n";
+    }
+}
+
 // display main menu
 void displayMenu() {
     std::cout << "\n=== FRAUD DETECTION SYSTEM MENU ===\n";
@@ -303,8 +1055,21 @@ void displayMenu() {
     std::cout << "6. Run all functions\n";
     std::cout << "7. Check CSV header and column mapping\n";
     std::cout << "8. Show fraud statistics\n";
+    std::cout << "9. Load zero-copy views\n";
+    std::cout << "10. Compare columnar store\n";
+    std::cout << "11. Query transactions by time range\n";
+    std::cout << "12. Save binary snapshot\n";
+    std::cout << "13. Benchmark linked list sort\n";
+    std::cout << "14. Benchmark sort strategies (merge vs counting)\n";
+    std::cout << "15. Parallel sort by any column\n";
+    std::cout << "16. Multi-key sort\n";
+    std::cout << "17. Bitmap index query\n";
+    std::cout << "18. Account history lookup\n";
+    std::cout << "19. Ad-hoc query (predicates on any column)\n";
+    std::cout << "20. Export JSON (pretty, compact, NDJSON; choose fields)\n";
+    std::cout << "21. Export CSV\n";
     std::cout << "0. Exit\n";
-    std::cout << "Enter your choice (0-8): ";
+    std::cout << "Enter your choice (0-21): ";
 }
 
 // load data from csv file with chunk selection
@@ -342,42 +1107,110 @@ bool loadData(ArrayStore& arrayStore, LinkedListStore& linkedListStore) {
             break;
     }
     
-    std::cout << "\nLoading " << (max_to_load == -1 ? "ALL" : std::to_string(max_to_load)) << " rows...\n";
+    // ingestion method selection
+    std::cout << "\n=== INGESTION METHOD ===\n";
+    std::cout << "1. Stream (getline + stringstream)\n";
+    std::cout << "2. Memory-mapped\n";
+    std::cout << "3. Memory-mapped, parallel (all cores)\n";
+    std::cout << "4. Binary snapshot (saved with menu option 12)\n";
+    std::cout << "Enter your choice (1-4): ";
     
-    // load data from csv file
-    std::ifstream file("data/financial_fraud_detection_dataset.csv");
-    if (!file) {
-        std::cerr << "Could not open CSV file! Please ensure 'data/financial_fraud_detection_dataset.csv' exists.\n";
-        return false;
-    }
+    int method;
+    std::cin >> method;
     
-    std::string line;
-    getline(file, line); // skip header
-    int count = 0;
+    std::cout << "\nLoading " << (max_to_load == -1 ? "ALL" : std::to_string(max_to_load)) << " rows...\n";
     
-    while (getline(file, line) && (max_to_load == -1 || count < max_to_load)) {
-        if (line.empty()) continue;
-        try {
-            Transaction t = parseTransaction(line);
-            arrayStore.addTransaction(t);
+    const std::string& path = DATA_PATH;
+    LoadStats stats;
+    
+    if (method == 2) {
+        if (!loadTransactionsMapped(path, max_to_load, arrayStore, linkedListStore, stats)) {
+            std::cerr << "Could not map CSV file! Please ensure '" << path << "' exists.\n";
+            return false;
+        }
+    } else if (method == 3) {
+        if (!loadTransactionsParallel(path, max_to_load, 0, arrayStore, linkedListStore, stats)) {
+            std::cerr << "Could not map CSV file! Please ensure '" << path << "' exists.\n";
+            return false;
+        }
+    } else if (method == 4) {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        
+        // map the snapshot (query-ready as a column store), then fill the
+        // row stores from its columns without parsing any text
+        ColumnStore snapshot(0);
+        if (!snapshot.loadSnapshot(SNAPSHOT_PATH)) {
+            std::cerr << "Could not load snapshot! Load the CSV and save one with menu option 12 first.\n";
+            return false;
+        }
+        std::cout << "Mapped snapshot with " << snapshot.getSize() << " rows in " << secondsSince(start) << " s\n";
+        
+        int count = snapshot.getSize();
+        if (max_to_load != -1 && max_to_load < count) count = max_to_load;
+        arrayStore.reserve(count);
+        for (int i = 0; i < count; ++i) {
+            Transaction t = snapshot.getTransaction(i);
             linkedListStore.addTransaction(t);
-            count++;
-            
-            // progress indicator for large loads
-            if (count % 10000 == 0) {
-                std::cout << "Loaded " << count << " rows...\n";
+            arrayStore.addTransaction(std::move(t));
+        }
+        
+        stats.rows = count;
+        stats.seconds = secondsSince(start);
+    } else {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        
+        // load data from csv file
+        std::ifstream file(path);
+        if (!file) {
+            std::cerr << "Could not open CSV file! Please ensure '" << path << "' exists.\n";
+            return false;
+        }
+        
+        std::string line;
+        getCsvRecord(file, line); // skip header
+        int count = 0;
+        
+        while (getCsvRecord(file, line) && (max_to_load == -1 || count < max_to_load)) {
+            if (line.empty()) continue;
+            try {
+                Transaction t = parseTransaction(line);
+                arrayStore.addTransaction(t);
+                linkedListStore.addTransaction(t);
+                count++;
+                
+                // progress indicator for large loads
+                if (count % 10000 == 0) {
+                    std::cout << "Loaded " << count << " rows...\n";
+                }
+            } catch (const std::exception& e) {
+                std::cout << "Error parsing line: " << e.what() << std::endl;
+                stats.errors++;
+                continue;
             }
-        } catch (const std::exception& e) {
-            std::cout << "Error parsing line: " << e.what() << std::endl;
-            continue;
         }
+        file.close();
+        
+        stats.rows = count;
+        stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
     }
-    file.close();
     
+    std::cout << "Ingested " << stats.rows << " rows in " << stats.seconds << " s ("
+              << (long long)stats.rowsPerSecond() << " rows/sec, " << stats.errors << " errors)\n";
     std::cout << "Loaded " << arrayStore.getSize() << " transactions into both data structures.\n";
     // print number of frauds found right after loading
-    ArrayStore fraudArray = arrayStore.getFraudulentTransactions();
+    ArraySelection fraudArray = arrayStore.getFraudulentTransactions();
     std::cout << "Immediately after loading: Found " << fraudArray.getSize() << " fraudulent transactions in ArrayStore.\n";
+    
+    // account indexes for per-account lookups (menu option 18)
+    std::chrono::steady_clock::time_point indexStart = std::chrono::steady_clock::now();
+    arrayStore.buildAccountIndexes();
+    double arrayIndexTime = secondsSince(indexStart);
+    indexStart = std::chrono::steady_clock::now();
+    linkedListStore.buildAccountIndexes();
+    double listIndexTime = secondsSince(indexStart);
+    std::cout << "Built sender/receiver account indexes: " << arrayIndexTime << " s, "
+              << arrayStore.accountIndexBytes() / (1024 * 1024) << " MB (array); " << listIndexTime << " s, "
+              << linkedListStore.accountIndexBytes() / (1024 * 1024) << " MB (linked list)\n";
     return true;
 }
 
@@ -425,11 +1258,50 @@ void runMainProgram() {
             case 8:
                 showFraudStatistics(arrayStore, linkedListStore);
                 break;
+            case 9:
+                demonstrateZeroCopyViews(arrayStore);
+                break;
+            case 10:
+                demonstrateColumnStore(arrayStore);
+                break;
+            case 11:
+                demonstrateTimeRangeQuery(arrayStore);
+                break;
+            case 12:
+                saveSnapshot(arrayStore);
+                break;
+            case 13:
+                benchmarkLinkedListSort(arrayStore);
+                break;
+            case 14:
+                benchmarkSortStrategies(arrayStore, linkedListStore);
+                break;
+            case 15:
+                demonstrateParallelSort(arrayStore);
+                break;
+            case 16:
+                demonstrateMultiKeySort(arrayStore, linkedListStore);
+                break;
+            case 17:
+                demonstrateBitmapIndex(arrayStore);
+                break;
+            case 18:
+                demonstrateAccountLookup(arrayStore, linkedListStore);
+                break;
+            case 19:
+                demonstrateQueryEngine(arrayStore, linkedListStore);
+                break;
+            case 20:
+                demonstrateExportFormats(arrayStore);
+                break;
+            case 21:
+                demonstrateCSVExport(arrayStore, linkedListStore);
+                break;
             case 0:
                 std::cout << "Exiting program...\n";
                 break;
             default:
-                std::cout << "Invalid choice! Please enter a number between 0 and 8.\n";
+                std::cout << "Invalid choice! Please enter a number between 0 and 21.\n";
                 break;
         }
         
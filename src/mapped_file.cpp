@@ -0,0 +1,116 @@
+#include "mapped_file.hpp"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Constructor: starts with nothing mapped
+MappedFile::MappedFile() {
+    bytes = nullptr;
+    length = 0;
+#ifdef _WIN32
+    fileHandle = INVALID_HANDLE_VALUE;
+    mappingHandle = nullptr;
+#else
+    fd = -1;
+#endif
+}
+
+// Destructor: releases the mapping
+MappedFile::~MappedFile() {
+    close();
+}
+
+#ifdef _WIN32
+
+// Maps the whole file read-only using the Win32 file mapping API
+bool MappedFile::open(const std::string& path) {
+    close();
+    fileHandle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                             OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (fileHandle == INVALID_HANDLE_VALUE) return false;
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(fileHandle, &fileSize)) {
+        close();
+        return false;
+    }
+    length = (size_t)fileSize.QuadPart;
+    if (length == 0) return true; // empty files cannot be mapped, but are valid
+
+    mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mappingHandle == nullptr) {
+        close();
+        return false;
+    }
+    bytes = (const char*)MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+    if (bytes == nullptr) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+// Unmaps the view and closes both handles
+void MappedFile::close() {
+    if (bytes != nullptr) UnmapViewOfFile(bytes);
+    if (mappingHandle != nullptr) CloseHandle(mappingHandle);
+    if (fileHandle != INVALID_HANDLE_VALUE) CloseHandle(fileHandle);
+    bytes = nullptr;
+    length = 0;
+    mappingHandle = nullptr;
+    fileHandle = INVALID_HANDLE_VALUE;
+}
+
+#else
+
+// Maps the whole file read-only with mmap
+bool MappedFile::open(const std::string& path) {
+    close();
+    fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        close();
+        return false;
+    }
+    length = (size_t)info.st_size;
+    if (length == 0) return true; // empty files cannot be mapped, but are valid
+
+    void* mapped = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapped == MAP_FAILED) {
+        close();
+        return false;
+    }
+    // the file is read front to back, so ask the kernel for aggressive readahead
+    madvise(mapped, length, MADV_SEQUENTIAL);
+    bytes = (const char*)mapped;
+    return true;
+}
+
+// Unmaps the region and closes the descriptor
+void MappedFile::close() {
+    if (bytes != nullptr) munmap((void*)bytes, length);
+    if (fd >= 0) ::close(fd);
+    bytes = nullptr;
+    length = 0;
+    fd = -1;
+}
+
+#endif
+
+// Returns the start of the mapped bytes
+const char* MappedFile::data() const {
+    return bytes;
+}
+
+// Returns the number of mapped bytes
+size_t MappedFile::size() const {
+    return length;
+}
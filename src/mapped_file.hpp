@@ -0,0 +1,38 @@
+#ifndef MAPPED_FILE_HPP
+#define MAPPED_FILE_HPP
+
+#include <string>
+#include <cstddef>
+
+// Read-only memory mapping of an entire file
+class MappedFile {
+private:
+    const char* bytes; // Start of the mapped region (nullptr when closed)
+    size_t length;     // Size of the mapped region in bytes
+#ifdef _WIN32
+    void* fileHandle;    // Win32 file handle
+    void* mappingHandle; // Win32 file mapping handle
+#else
+    int fd;              // POSIX file descriptor
+#endif
+
+public:
+    MappedFile();
+    ~MappedFile();
+
+    // Not copyable: the mapping is owned by exactly one object
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // Map the whole file read-only; returns false if it cannot be opened or mapped
+    bool open(const std::string& path);
+
+    // Unmap the file and release the handles
+    void close();
+
+    // Mapped bytes and their count
+    const char* data() const;
+    size_t size() const;
+};
+
+#endif // MAPPED_FILE_HPP
@@ -0,0 +1,139 @@
+#include "numeric_parse.hpp"
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <cctype>
+#include <climits>
+
+// Powers of ten that are exactly representable as doubles
+static const double EXACT_POWERS_OF_TEN[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+// Largest mantissa whose every value is exact in a double (2^53)
+static const uint64_t MAX_EXACT_MANTISSA = (uint64_t)1 << 53;
+
+// Slow path: strtod on a NUL-terminated copy
+static bool parseDoubleFallback(const char* begin, const char* end, double& value) {
+    char buffer[128];
+    size_t length = end - begin;
+    if (length == 0 || length >= sizeof(buffer)) return false;
+    if (std::isspace((unsigned char)*begin)) return false; // strtod would skip it
+    std::memcpy(buffer, begin, length);
+    buffer[length] = '\0';
+    char* parsedEnd = nullptr;
+    value = std::strtod(buffer, &parsedEnd);
+    return parsedEnd == buffer + length;
+}
+
+// Fast path for plain decimals, falling back to strtod when exactness is not guaranteed
+bool parseDouble(const char* begin, const char* end, double& value) {
+    const char* p = begin;
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+')) {
+        negative = (*p == '-');
+        ++p;
+    }
+
+    uint64_t mantissa = 0;
+    int digits = 0;       // significant digits accumulated into mantissa
+    int exponent = 0;     // power of ten applied to mantissa
+    bool sawDigit = false;
+
+    // integer part
+    while (p < end && *p >= '0' && *p <= '9') {
+        sawDigit = true;
+        if (mantissa != 0 || *p != '0') {
+            if (digits >= 19) return parseDoubleFallback(begin, end, value);
+            mantissa = mantissa * 10 + (*p - '0');
+            digits++;
+        }
+        ++p;
+    }
+    // fraction part
+    if (p < end && *p == '.') {
+        ++p;
+        while (p < end && *p >= '0' && *p <= '9') {
+            sawDigit = true;
+            if (mantissa != 0 || *p != '0') {
+                if (digits >= 19) return parseDoubleFallback(begin, end, value);
+                mantissa = mantissa * 10 + (*p - '0');
+                digits++;
+            }
+            exponent--;
+            ++p;
+        }
+    }
+    if (!sawDigit) return parseDoubleFallback(begin, end, value); // "nan", "inf", ...
+
+    // exponent part
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        ++p;
+        bool negativeExponent = false;
+        if (p < end && (*p == '-' || *p == '+')) {
+            negativeExponent = (*p == '-');
+            ++p;
+        }
+        if (p == end) return false;
+        int explicitExponent = 0;
+        while (p < end && *p >= '0' && *p <= '9') {
+            if (explicitExponent < 10000) explicitExponent = explicitExponent * 10 + (*p - '0');
+            ++p;
+        }
+        exponent += negativeExponent ? -explicitExponent : explicitExponent;
+    }
+    if (p != end) return false;
+
+    // exact when both the mantissa and the power of ten are exact doubles:
+    // a single correctly rounded multiply or divide then gives the right answer
+    if (mantissa <= MAX_EXACT_MANTISSA && exponent >= -22 && exponent <= 22) {
+        double result = (double)mantissa;
+        if (exponent < 0) result /= EXACT_POWERS_OF_TEN[-exponent];
+        else result *= EXACT_POWERS_OF_TEN[exponent];
+        value = negative ? -result : result;
+        return true;
+    }
+    return parseDoubleFallback(begin, end, value);
+}
+
+// Parses an optionally signed decimal integer that fits in an int
+bool parseInt(const char* begin, const char* end, int& value) {
+    const char* p = begin;
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+')) {
+        negative = (*p == '-');
+        ++p;
+    }
+    if (p == end) return false;
+
+    long long result = 0;
+    for (; p < end; ++p) {
+        if (*p < '0' || *p > '9') return false;
+        result = result * 10 + (*p - '0');
+        if (result > (long long)INT_MAX + 1) return false;
+    }
+    if (negative) result = -result;
+    if (result > INT_MAX || result < INT_MIN) return false;
+    value = (int)result;
+    return true;
+}
+
+// Parses true/false (case-insensitive) or 1/0
+bool parseBool(const char* begin, const char* end, bool& value) {
+    size_t length = end - begin;
+    if (length == 1 && (*begin == '1' || *begin == '0')) {
+        value = (*begin == '1');
+        return true;
+    }
+    const char* text = nullptr;
+    if (length == 4) text = "true";
+    else if (length == 5) text = "false";
+    else return false;
+
+    for (size_t i = 0; i < length; ++i) {
+        if (std::tolower((unsigned char)begin[i]) != text[i]) return false;
+    }
+    value = (length == 4);
+    return true;
+}
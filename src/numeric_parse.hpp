@@ -0,0 +1,20 @@
+#ifndef NUMERIC_PARSE_HPP
+#define NUMERIC_PARSE_HPP
+
+#include <cstddef>
+
+// Locale-independent parsers for trimmed CSV fields. Each one must consume the
+// whole field and returns false (leaving value unspecified) if it cannot.
+
+// Decimal floating point such as "-0.21", "343.78" or "1e-3". Values with at
+// most 15 significant digits and a small exponent are computed exactly with one
+// multiply or divide; anything else falls back to strtod.
+bool parseDouble(const char* begin, const char* end, double& value);
+
+// Optional sign followed by decimal digits
+bool parseInt(const char* begin, const char* end, int& value);
+
+// "true"/"false" (any case) or "1"/"0"
+bool parseBool(const char* begin, const char* end, bool& value);
+
+#endif // NUMERIC_PARSE_HPP
@@ -0,0 +1,126 @@
+#ifndef PARALLEL_SORT_HPP
+#define PARALLEL_SORT_HPP
+
+#include <vector>
+#include <thread>
+#include <algorithm>
+#include <cstddef>
+
+// Parallel merge sort of row numbers. less(a, b) must be a strict total order
+// on the rows (break ties on the row number to make the result stable); it is
+// called from several threads at once, so it must only read shared data.
+
+// Below this many items per thread the sort runs on the calling thread only
+const size_t MIN_PARALLEL_SORT_ITEMS = 1 << 14;
+
+// Bottom-up merge sort of items[0, n) using scratch[0, n) as the merge buffer
+template <typename Less>
+void mergeSortRange(int* items, size_t n, int* scratch, Less less) {
+    int* from = items;
+    int* to = scratch;
+    for (size_t width = 1; width < n; width *= 2) {
+        for (size_t left = 0; left < n; left += 2 * width) {
+            size_t mid = std::min(left + width, n);
+            size_t right = std::min(left + 2 * width, n);
+            std::merge(from + left, from + mid, from + mid, from + right, to + left, less);
+        }
+        std::swap(from, to);
+    }
+    if (from != items) std::copy(from, from + n, items);
+}
+
+// Runs work(0) .. work(count - 1) on count threads (the caller runs work(0))
+template <typename Work>
+void runOnThreads(int count, Work work) {
+    std::vector<std::thread> workers;
+    for (int i = 1; i < count; ++i) {
+        workers.push_back(std::thread(work, i));
+    }
+    work(0);
+    for (size_t i = 0; i < workers.size(); ++i) {
+        workers[i].join();
+    }
+}
+
+// Sorts items with numThreads threads (0 = one per core):
+//  1. the items are split into one run per thread and each run is merge sorted
+//  2. every run contributes evenly spaced samples; sorting the samples gives
+//     numThreads - 1 splitters that cut the output into similar-sized parts
+//  3. each thread binary-searches the splitters in every run and does a
+//     multiway merge of its slices straight into its part of the output
+template <typename Less>
+void parallelMergeSort(std::vector<int>& items, int numThreads, Less less) {
+    size_t n = items.size();
+    if (numThreads <= 0) {
+        numThreads = (int)std::thread::hardware_concurrency();
+        if (numThreads <= 0) numThreads = 1;
+    }
+    if (n / MIN_PARALLEL_SORT_ITEMS < (size_t)numThreads) {
+        numThreads = (int)(n / MIN_PARALLEL_SORT_ITEMS) + 1;
+    }
+    std::vector<int> scratch(n);
+    if (numThreads == 1) {
+        mergeSortRange(items.data(), n, scratch.data(), less);
+        return;
+    }
+
+    // 1. sort one run per thread
+    std::vector<size_t> runStart(numThreads + 1);
+    for (int t = 0; t <= numThreads; ++t) {
+        runStart[t] = n * t / numThreads;
+    }
+    runOnThreads(numThreads, [&](int t) {
+        mergeSortRange(items.data() + runStart[t], runStart[t + 1] - runStart[t],
+                       scratch.data() + runStart[t], less);
+    });
+
+    // 2. regular sampling: numThreads samples per run, every numThreads-th sorted sample splits
+    std::vector<int> samples;
+    for (int t = 0; t < numThreads; ++t) {
+        size_t length = runStart[t + 1] - runStart[t];
+        for (int s = 0; s < numThreads; ++s) {
+            samples.push_back(items[runStart[t] + length * s / numThreads]);
+        }
+    }
+    std::sort(samples.begin(), samples.end(), less);
+    std::vector<int> splitters;
+    for (int p = 1; p < numThreads; ++p) {
+        splitters.push_back(samples[p * numThreads]);
+    }
+
+    // cut[p][r]: where part p starts in run r (items before the p-th splitter)
+    std::vector<std::vector<size_t> > cut(numThreads + 1, std::vector<size_t>(numThreads));
+    for (int r = 0; r < numThreads; ++r) {
+        cut[0][r] = runStart[r];
+        cut[numThreads][r] = runStart[r + 1];
+        for (int p = 1; p < numThreads; ++p) {
+            cut[p][r] = std::lower_bound(items.begin() + runStart[r], items.begin() + runStart[r + 1],
+                                         splitters[p - 1], less) - items.begin();
+        }
+    }
+
+    // 3. each part merges its slice of every run into scratch at its output offset
+    runOnThreads(numThreads, [&](int p) {
+        size_t out = 0;
+        std::vector<size_t> next(numThreads), end(numThreads);
+        for (int r = 0; r < numThreads; ++r) {
+            out += cut[p][r] - runStart[r];
+            next[r] = cut[p][r];
+            end[r] = cut[p + 1][r];
+        }
+        while (true) {
+            // the runs are few, so a linear scan for the smallest head is enough
+            int best = -1;
+            for (int r = 0; r < numThreads; ++r) {
+                if (next[r] < end[r] && (best < 0 || less(items[next[r]], items[next[best]]))) {
+                    best = r;
+                }
+            }
+            if (best < 0) break;
+            scratch[out++] = items[next[best]++];
+        }
+    });
+    items.swap(scratch);
+}
+
+#endif // PARALLEL_SORT_HPP
@@ -0,0 +1,346 @@
+#include "query.hpp"
+#include "numeric_parse.hpp"
+#include "timestamp.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// Rows evaluated together; the batch buffers stay in L1/L2 cache
+static const int BATCH_ROWS = 1024;
+
+// How a compiled predicate is evaluated
+enum PredicateKind {
+    KIND_RANGE,      // low <= number <= high (=, <, >, between on numeric columns)
+    KIND_NOT_EQUAL,  // number != low, and not NaN
+    KIND_NUMBER_SET, // number is one of numbers (in on numeric columns)
+    KIND_CODES,      // codes[code] is set (every operator on categorical columns)
+    KIND_TEXT        // byte-wise test of the string (string columns)
+};
+
+// A predicate with its values parsed for the column
+struct CompiledPredicate {
+    const Predicate* predicate;
+    PredicateKind kind;
+    double low, high;                 // KIND_RANGE, KIND_NOT_EQUAL
+    std::vector<double> numbers;      // KIND_NUMBER_SET, sorted
+    std::vector<unsigned char> codes; // KIND_CODES, one entry per dictionary code
+};
+
+// ---- kernels: each appends the positions j of the passing values to out ----
+
+// Branch-free append of the set lanes of a compare mask
+static inline int appendMask(int mask, int lanes, int j, int* out, int k) {
+    for (int lane = 0; lane < lanes; ++lane) {
+        out[k] = j + lane;
+        k += (mask >> lane) & 1;
+    }
+    return k;
+}
+
+// low <= v[j] <= high (ordered compares, so NaN never passes)
+static int selectRange(const double* v, int n, double low, double high, int* out) {
+    int k = 0, j = 0;
+#if defined(__AVX__)
+    __m256d lo = _mm256_set1_pd(low), hi = _mm256_set1_pd(high);
+    for (; j + 4 <= n; j += 4) {
+        __m256d x = _mm256_loadu_pd(v + j);
+        __m256d pass = _mm256_and_pd(_mm256_cmp_pd(x, lo, _CMP_GE_OQ), _mm256_cmp_pd(x, hi, _CMP_LE_OQ));
+        k = appendMask(_mm256_movemask_pd(pass), 4, j, out, k);
+    }
+#elif defined(__SSE2__)
+    __m128d lo = _mm_set1_pd(low), hi = _mm_set1_pd(high);
+    for (; j + 2 <= n; j += 2) {
+        __m128d x = _mm_loadu_pd(v + j);
+        __m128d pass = _mm_and_pd(_mm_cmpge_pd(x, lo), _mm_cmple_pd(x, hi));
+        k = appendMask(_mm_movemask_pd(pass), 2, j, out, k);
+    }
+#endif
+    for (; j < n; ++j) {
+        out[k] = j;
+        k += (v[j] >= low) & (v[j] <= high);
+    }
+    return k;
+}
+
+// v[j] != value and v[j] is not NaN
+static int selectNotEqual(const double* v, int n, double value, int* out) {
+    int k = 0, j = 0;
+#if defined(__AVX__)
+    __m256d x0 = _mm256_set1_pd(value);
+    for (; j + 4 <= n; j += 4) {
+        __m256d x = _mm256_loadu_pd(v + j);
+        k = appendMask(_mm256_movemask_pd(_mm256_cmp_pd(x, x0, _CMP_NEQ_OQ)), 4, j, out, k);
+    }
+#elif defined(__SSE2__)
+    __m128d x0 = _mm_set1_pd(value);
+    for (; j + 2 <= n; j += 2) {
+        __m128d x = _mm_loadu_pd(v + j);
+        __m128d pass = _mm_and_pd(_mm_cmpneq_pd(x, x0), _mm_cmpord_pd(x, x));
+        k = appendMask(_mm_movemask_pd(pass), 2, j, out, k);
+    }
+#endif
+    for (; j < n; ++j) {
+        out[k] = j;
+        k += (v[j] != value) & (v[j] == v[j]);
+    }
+    return k;
+}
+
+// v[j] is in the sorted set (NaN is unordered, so binary search would
+// report it as found; it is rejected first)
+static int selectNumberSet(const double* v, int n, const std::vector<double>& set, int* out) {
+    int k = 0;
+    for (int j = 0; j < n; ++j) {
+        out[k] = j;
+        k += (v[j] == v[j] && std::binary_search(set.begin(), set.end(), v[j])) ? 1 : 0;
+    }
+    return k;
+}
+
+// table[c[j]] is set
+static int selectCodes(const CategoryCode* c, int n, const unsigned char* table, int* out) {
+    int k = 0;
+    for (int j = 0; j < n; ++j) {
+        out[k] = j;
+        k += table[c[j]];
+    }
+    return k;
+}
+
+// ---- compiling predicates ----
+
+// Byte-wise comparison of a value with an operand (like std::string::compare)
+static int compareText(const char* data, size_t length, const std::string& operand) {
+    int c = std::memcmp(data, operand.data(), std::min(length, operand.size()));
+    if (c != 0) return c;
+    return (length < operand.size()) ? -1 : (length > operand.size() ? 1 : 0);
+}
+
+// Whether a string value satisfies p
+static bool textMatches(const Predicate& p, const char* data, size_t length) {
+    switch (p.op) {
+        case PRED_EQUAL: return compareText(data, length, p.values[0]) == 0;
+        case PRED_NOT_EQUAL: return compareText(data, length, p.values[0]) != 0;
+        case PRED_LESS: return compareText(data, length, p.values[0]) < 0;
+        case PRED_GREATER: return compareText(data, length, p.values[0]) > 0;
+        case PRED_BETWEEN:
+            return compareText(data, length, p.values[0]) >= 0 && compareText(data, length, p.values[1]) <= 0;
+        case PRED_IN:
+            for (size_t i = 0; i < p.values.size(); ++i) {
+                if (compareText(data, length, p.values[i]) == 0) return true;
+            }
+            return false;
+        default: // PRED_PREFIX
+            return length >= p.values[0].size()
+                && std::memcmp(data, p.values[0].data(), p.values[0].size()) == 0;
+    }
+}
+
+// Parses an operand of a numeric, timestamp or bool column
+static double parseOperand(int column, const std::string& text) {
+    const char* begin = text.data();
+    const char* end = begin + text.size();
+    switch (columnType(column)) {
+        case TYPE_TIMESTAMP: {
+            int64_t micros;
+            if (!parseTimestamp(begin, end, micros)) {
+                throw std::invalid_argument(std::string(columnName(column)) + ": not a timestamp: " + text);
+            }
+            return (double)micros; // exact: epoch microseconds stay below 2^53
+        }
+        case TYPE_BOOL: {
+            bool flag;
+            if (!parseBool(begin, end, flag)) {
+                throw std::invalid_argument(std::string(columnName(column)) + ": not true/false: " + text);
+            }
+            return flag ? 1.0 : 0.0;
+        }
+        default: {
+            double value;
+            if (!parseDouble(begin, end, value)) {
+                throw std::invalid_argument(std::string(columnName(column)) + ": not a number: " + text);
+            }
+            return value;
+        }
+    }
+}
+
+// Checks the operand count, then turns the predicate into a kernel and its arguments
+static CompiledPredicate compile(const Predicate& p) {
+    if (p.column < 0 || p.column >= COLUMN_COUNT) {
+        throw std::invalid_argument("unknown column in predicate");
+    }
+    size_t needed = (p.op == PRED_BETWEEN) ? 2 : 1;
+    if ((p.op == PRED_IN) ? p.values.empty() : p.values.size() != needed) {
+        throw std::invalid_argument(std::string(columnName(p.column)) + ": wrong number of values");
+    }
+
+    CompiledPredicate c;
+    c.predicate = &p;
+    c.low = c.high = 0;
+    ColumnType type = columnType(p.column);
+    if (type == TYPE_STRING) {
+        c.kind = KIND_TEXT;
+    } else if (type == TYPE_CATEGORY) {
+        // evaluate the predicate once per distinct value
+        const StringDictionary& dictionary = dictionaryFor(p.column);
+        c.kind = KIND_CODES;
+        c.codes.resize(dictionary.size());
+        for (int code = 0; code < dictionary.size(); ++code) {
+            const std::string& value = dictionary.lookup((CategoryCode)code);
+            c.codes[code] = textMatches(p, value.data(), value.size()) ? 1 : 0;
+        }
+    } else {
+        const double inf = std::numeric_limits<double>::infinity();
+        switch (p.op) {
+            case PRED_EQUAL:
+                c.kind = KIND_RANGE;
+                c.low = c.high = parseOperand(p.column, p.values[0]);
+                break;
+            case PRED_NOT_EQUAL:
+                c.kind = KIND_NOT_EQUAL;
+                c.low = parseOperand(p.column, p.values[0]);
+                break;
+            case PRED_LESS: // v < x is v <= the next double below x
+                c.kind = KIND_RANGE;
+                c.low = -inf;
+                c.high = std::nextafter(parseOperand(p.column, p.values[0]), -inf);
+                break;
+            case PRED_GREATER:
+                c.kind = KIND_RANGE;
+                c.low = std::nextafter(parseOperand(p.column, p.values[0]), inf);
+                c.high = inf;
+                break;
+            case PRED_BETWEEN:
+                c.kind = KIND_RANGE;
+                c.low = parseOperand(p.column, p.values[0]);
+                c.high = parseOperand(p.column, p.values[1]);
+                break;
+            case PRED_IN:
+                c.kind = KIND_NUMBER_SET;
+                for (size_t i = 0; i < p.values.size(); ++i) {
+                    c.numbers.push_back(parseOperand(p.column, p.values[i]));
+                }
+                std::sort(c.numbers.begin(), c.numbers.end());
+                break;
+            default:
+                throw std::invalid_argument(std::string(columnName(p.column)) + ": prefix needs a text column");
+        }
+    }
+    return c;
+}
+
+// Cheap kernels first, so string tests only see rows the others kept
+static int cost(const CompiledPredicate& c) {
+    switch (c.kind) {
+        case KIND_TEXT: return 2;
+        case KIND_NUMBER_SET: return 1;
+        default: return 0;
+    }
+}
+
+// ---- Query ----
+
+Query& Query::where(const Predicate& predicate) {
+    predicates.push_back(predicate);
+    return *this;
+}
+
+Query& Query::where(int column, PredicateOp op, const std::string& value) {
+    Predicate p;
+    p.column = column;
+    p.op = op;
+    p.values.push_back(value);
+    return where(p);
+}
+
+Query& Query::between(int column, const std::string& low, const std::string& high) {
+    Predicate p;
+    p.column = column;
+    p.op = PRED_BETWEEN;
+    p.values.push_back(low);
+    p.values.push_back(high);
+    return where(p);
+}
+
+Query& Query::in(int column, const std::vector<std::string>& values) {
+    Predicate p;
+    p.column = column;
+    p.op = PRED_IN;
+    p.values = values;
+    return where(p);
+}
+
+size_t Query::size() const {
+    return predicates.size();
+}
+
+// For each batch: start with every row selected, then let each predicate
+// gather its column for the selected rows, run its kernel, and compact the
+// selection vector to the rows that passed
+std::vector<int> Query::matchingRows(const QuerySource& source, const int* candidates, int count) const {
+    std::vector<CompiledPredicate> compiled;
+    for (size_t i = 0; i < predicates.size(); ++i) {
+        compiled.push_back(compile(predicates[i]));
+    }
+    std::stable_sort(compiled.begin(), compiled.end(),
+                     [](const CompiledPredicate& a, const CompiledPredicate& b) { return cost(a) < cost(b); });
+
+    std::vector<int> result;
+    std::vector<int> selection(BATCH_ROWS);
+    std::vector<int> passed(BATCH_ROWS);
+    std::vector<double> numbers(BATCH_ROWS);
+    std::vector<CategoryCode> codes(BATCH_ROWS);
+
+    for (int base = 0; base < count; base += BATCH_ROWS) {
+        int selected = std::min(BATCH_ROWS, count - base);
+        for (int j = 0; j < selected; ++j) {
+            selection[j] = candidates ? candidates[base + j] : base + j;
+        }
+
+        for (size_t i = 0; i < compiled.size() && selected > 0; ++i) {
+            const CompiledPredicate& c = compiled[i];
+            int column = c.predicate->column;
+            int kept = 0;
+            switch (c.kind) {
+                case KIND_RANGE:
+                    source.gatherNumbers(column, selection.data(), selected, numbers.data());
+                    kept = selectRange(numbers.data(), selected, c.low, c.high, passed.data());
+                    break;
+                case KIND_NOT_EQUAL:
+                    source.gatherNumbers(column, selection.data(), selected, numbers.data());
+                    kept = selectNotEqual(numbers.data(), selected, c.low, passed.data());
+                    break;
+                case KIND_NUMBER_SET:
+                    source.gatherNumbers(column, selection.data(), selected, numbers.data());
+                    kept = selectNumberSet(numbers.data(), selected, c.numbers, passed.data());
+                    break;
+                case KIND_CODES:
+                    source.gatherCodes(column, selection.data(), selected, codes.data());
+                    kept = selectCodes(codes.data(), selected, c.codes.data(), passed.data());
+                    break;
+                case KIND_TEXT:
+                    for (int j = 0; j < selected; ++j) {
+                        StringRef value = source.text(column, selection[j]);
+                        passed[kept] = j;
+                        kept += textMatches(*c.predicate, value.data, value.size) ? 1 : 0;
+                    }
+                    break;
+            }
+            // passed is increasing and passed[j] >= j, so compacting in place is safe
+            for (int j = 0; j < kept; ++j) {
+                selection[j] = selection[passed[j]];
+            }
+            selected = kept;
+        }
+        result.insert(result.end(), selection.begin(), selection.begin() + selected);
+    }
+    return result;
+}
@@ -0,0 +1,123 @@
+#ifndef QUERY_HPP
+#define QUERY_HPP
+
+#include <string>
+#include <vector>
+#include "transaction.hpp"
+#include "transaction_view.hpp" // StringRef
+
+// Comparison applied by a predicate. Numbers and timestamps compare by value,
+// strings and categories byte-wise; a missing (NaN) number matches nothing.
+enum PredicateOp {
+    PRED_EQUAL,       // column = value
+    PRED_NOT_EQUAL,   // column != value
+    PRED_LESS,        // column < value
+    PRED_GREATER,     // column > value
+    PRED_BETWEEN,     // low <= column <= high (two values)
+    PRED_IN,          // column equals one of the values
+    PRED_PREFIX       // column starts with value (string and categorical columns)
+};
+
+// One condition on one column. Values are given as text and parsed for the
+// column's type when the query runs (timestamps as "YYYY-MM-DDTHH:MM:SS",
+// is_fraud as true/false).
+struct Predicate {
+    int column;                      // TransactionColumn
+    PredicateOp op;
+    std::vector<std::string> values; // One value, two for PRED_BETWEEN, any number for PRED_IN
+};
+
+// Read access a query needs from a store, a batch of rows at a time. Row
+// numbers are whatever the store uses to address its rows (array positions,
+// list positions).
+class QuerySource {
+public:
+    virtual ~QuerySource() {}
+
+    // Values of a numeric, timestamp or bool column (bool as 0/1) as doubles
+    virtual void gatherNumbers(int column, const int* rows, int count, double* out) const = 0;
+
+    // Dictionary codes of a categorical column
+    virtual void gatherCodes(int column, const int* rows, int count, CategoryCode* out) const = 0;
+
+    // Value of a string column
+    virtual StringRef text(int column, int row) const = 0;
+};
+
+// QuerySource over Transaction objects, for the row-oriented stores;
+// rowAt(r) returns the Transaction of row r. The column is resolved to a
+// member pointer once per batch, not once per row.
+template <typename RowAt>
+class TransactionQuerySource : public QuerySource {
+private:
+    RowAt rowAt;
+
+public:
+    explicit TransactionQuerySource(RowAt rows) : rowAt(rows) {}
+
+    void gatherNumbers(int column, const int* rows, int count, double* out) const {
+        double Transaction::* field = nullptr;
+        switch (column) {
+            case COL_TIMESTAMP:
+                for (int i = 0; i < count; ++i) out[i] = (double)rowAt(rows[i]).timestamp;
+                return;
+            case COL_VELOCITY_SCORE:
+                for (int i = 0; i < count; ++i) out[i] = rowAt(rows[i]).velocity_score;
+                return;
+            case COL_IS_FRAUD:
+                for (int i = 0; i < count; ++i) out[i] = rowAt(rows[i]).is_fraud ? 1.0 : 0.0;
+                return;
+            case COL_AMOUNT: field = &Transaction::amount; break;
+            case COL_TIME_SINCE_LAST_TRANSACTION: field = &Transaction::time_since_last_transaction; break;
+            case COL_SPENDING_DEVIATION: field = &Transaction::spending_deviation; break;
+            default: field = &Transaction::geo_anomaly; break;
+        }
+        for (int i = 0; i < count; ++i) out[i] = rowAt(rows[i]).*field;
+    }
+
+    void gatherCodes(int column, const int* rows, int count, CategoryCode* out) const {
+        CategoryCode Transaction::* field;
+        switch (column) {
+            case COL_TRANSACTION_TYPE: field = &Transaction::transaction_type; break;
+            case COL_MERCHANT_CATEGORY: field = &Transaction::merchant_category; break;
+            case COL_LOCATION: field = &Transaction::location; break;
+            case COL_DEVICE_USED: field = &Transaction::device_used; break;
+            default: field = &Transaction::payment_channel; break;
+        }
+        for (int i = 0; i < count; ++i) out[i] = rowAt(rows[i]).*field;
+    }
+
+    StringRef text(int column, int row) const {
+        const std::string& value = rowAt(row).stringValue(column);
+        StringRef ref = {value.data(), value.size()};
+        return ref;
+    }
+};
+
+// A conjunction of predicates (every predicate must hold). Rows are evaluated
+// in batches: each predicate narrows the batch's selection vector, so later
+// predicates only look at rows that are still selected. Numeric predicates
+// become range tests run by SIMD compare kernels, categorical ones a lookup
+// table over the dictionary codes, and string predicates are checked last.
+class Query {
+private:
+    std::vector<Predicate> predicates;
+
+public:
+    // Add a predicate (returns *this so calls can be chained)
+    Query& where(const Predicate& predicate);
+    Query& where(int column, PredicateOp op, const std::string& value);
+    Query& between(int column, const std::string& low, const std::string& high);
+    Query& in(int column, const std::vector<std::string>& values);
+
+    // Number of predicates
+    size_t size() const;
+
+    // Rows that satisfy every predicate, in the order given. candidates lists
+    // the rows to test (count of them); nullptr means rows 0 .. count - 1.
+    // Throws std::invalid_argument if a value does not parse for its column
+    // or an operator does not apply to it.
+    std::vector<int> matchingRows(const QuerySource& source, const int* candidates, int count) const;
+};
+
+#endif // QUERY_HPP
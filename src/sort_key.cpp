@@ -0,0 +1,148 @@
+#include "sort_key.hpp"
+#include "parallel_sort.hpp"
+
+// Bytes of the row number appended to every key
+static const size_t ROW_BYTES = 4;
+
+// Maps a double to an integer with the same order (-0.0 equals 0.0 and NaN,
+// a missing value, sorts after every number)
+uint64_t orderedDoubleKey(double value) {
+    if (isNull(value)) return ~(uint64_t)0;
+    if (value == 0.0) value = 0.0;
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    // negative numbers: flip all bits; positive numbers: set the sign bit
+    return (bits >> 63) ? ~bits : bits | ((uint64_t)1 << 63);
+}
+
+// Maps a signed integer to an unsigned one with the same order
+uint64_t orderedIntKey(int64_t value) {
+    return (uint64_t)value ^ ((uint64_t)1 << 63);
+}
+
+// Fixed field widths; string fields start empty and grow in fitString
+static size_t fieldBytes(int column) {
+    switch (columnType(column)) {
+        case TYPE_CATEGORY: return sizeof(CategoryCode);
+        case TYPE_BOOL: return 1;
+        case TYPE_INT: return 4;
+        case TYPE_STRING: return 0;
+        default: return 8; // timestamps and doubles
+    }
+}
+
+// Constructor: lays out the fields and loads the ranks of categorical keys
+SortKeyTable::SortKeyTable(const std::vector<SortKey>& sortKeys) : keys(sortKeys) {
+    fieldWidth.resize(keys.size());
+    ranks.resize(keys.size());
+    for (size_t k = 0; k < keys.size(); ++k) {
+        fieldWidth[k] = fieldBytes(keys[k].column);
+        if (columnType(keys[k].column) == TYPE_CATEGORY) {
+            ranks[k] = dictionaryFor(keys[k].column).sortedRanks();
+        }
+    }
+    width = 0;
+}
+
+// Widens a string field to hold length bytes
+void SortKeyTable::fitString(size_t key, size_t length) {
+    if (length > fieldWidth[key]) fieldWidth[key] = length;
+}
+
+// Widens every string field for the values of t
+void SortKeyTable::fitRow(const Transaction& t) {
+    for (size_t k = 0; k < keys.size(); ++k) {
+        if (columnType(keys[k].column) == TYPE_STRING) {
+            fitString(k, t.stringValue(keys[k].column).size());
+        }
+    }
+}
+
+// Fixes the field offsets and writes the row numbers big-endian at the end
+void SortKeyTable::allocate(int rows) {
+    fieldOffset.resize(keys.size());
+    width = 0;
+    for (size_t k = 0; k < keys.size(); ++k) {
+        fieldOffset[k] = width;
+        width += fieldWidth[k];
+    }
+    width += ROW_BYTES;
+
+    bytes.assign((size_t)rows * width, 0);
+    for (int row = 0; row < rows; ++row) {
+        unsigned char* p = &bytes[(size_t)row * width + width - ROW_BYTES];
+        p[0] = (unsigned char)(row >> 24);
+        p[1] = (unsigned char)(row >> 16);
+        p[2] = (unsigned char)(row >> 8);
+        p[3] = (unsigned char)row;
+    }
+}
+
+// Writes the low bytes of value, most significant first
+void SortKeyTable::putBits(int row, size_t key, uint64_t value) {
+    unsigned char* p = &bytes[(size_t)row * width + fieldOffset[key]];
+    size_t n = fieldWidth[key];
+    for (size_t i = 0; i < n; ++i) {
+        unsigned char b = (unsigned char)(value >> (8 * (n - 1 - i)));
+        p[i] = keys[key].descending ? (unsigned char)~b : b;
+    }
+}
+
+// Copies the bytes and zero-pads the rest of the field
+void SortKeyTable::putString(int row, size_t key, const char* data, size_t length) {
+    unsigned char* p = &bytes[(size_t)row * width + fieldOffset[key]];
+    size_t n = fieldWidth[key];
+    if (length > n) length = n; // fitString was not called for this value
+    std::memcpy(p, data, length);
+    std::memset(p + length, 0, n - length);
+    if (keys[key].descending) {
+        for (size_t i = 0; i < n; ++i) p[i] = (unsigned char)~p[i];
+    }
+}
+
+void SortKeyTable::putCode(int row, size_t key, CategoryCode code) {
+    putBits(row, key, (uint64_t)ranks[key][code]);
+}
+
+void SortKeyTable::putDouble(int row, size_t key, double value) {
+    putBits(row, key, orderedDoubleKey(value));
+}
+
+// Flips the sign bit of the field's width so negative values sort first
+void SortKeyTable::putInteger(int row, size_t key, int64_t value) {
+    putBits(row, key, (uint64_t)value ^ ((uint64_t)1 << (8 * fieldWidth[key] - 1)));
+}
+
+// Encodes every key field of t
+void SortKeyTable::putRow(int row, const Transaction& t) {
+    for (size_t k = 0; k < keys.size(); ++k) {
+        int col = keys[k].column;
+        switch (columnType(col)) {
+            case TYPE_STRING: {
+                const std::string& value = t.stringValue(col);
+                putString(row, k, value.data(), value.size());
+                break;
+            }
+            case TYPE_CATEGORY: putCode(row, k, t.categoryValue(col)); break;
+            case TYPE_TIMESTAMP: putInteger(row, k, t.timestamp); break;
+            case TYPE_INT: putInteger(row, k, t.velocity_score); break;
+            case TYPE_BOOL: putInteger(row, k, t.is_fraud ? 1 : 0); break;
+            default: putDouble(row, k, t.doubleValue(col)); break;
+        }
+    }
+}
+
+// Keys are unique (they end in the row number), so any correct sort is stable
+std::vector<int> SortKeyTable::sortedOrder() const {
+    int rows = width > 0 ? (int)(bytes.size() / width) : 0;
+    std::vector<int> order(rows);
+    for (int i = 0; i < rows; ++i) {
+        order[i] = i;
+    }
+    const unsigned char* base = bytes.data();
+    size_t w = width;
+    parallelMergeSort(order, 0, [base, w](int a, int b) {
+        return std::memcmp(base + (size_t)a * w, base + (size_t)b * w, w) < 0;
+    });
+    return order;
+}
@@ -0,0 +1,66 @@
+#ifndef SORT_KEY_HPP
+#define SORT_KEY_HPP
+
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <cstddef>
+#include "transaction.hpp"
+
+// One column of a multi-column sort
+struct SortKey {
+    int column;      // TransactionColumn
+    bool descending; // false = ascending
+};
+
+// Integers with the same order as the values they encode
+uint64_t orderedDoubleKey(double value); // -0.0 equals 0.0, NaN sorts after every number
+uint64_t orderedIntKey(int64_t value);
+
+// Normalized sort keys for a table of rows. Every row gets a fixed-width byte
+// string whose memcmp order is the requested multi-column order:
+//  - numbers are stored big-endian with their sign bit flipped (doubles are
+//    first mapped through orderedDoubleKey), categories as dictionary ranks
+//  - strings are stored as their bytes, zero-padded to the longest value
+//  - descending fields have all their bytes inverted
+//  - the row number comes last, so equal rows keep their order (stable)
+// Rows are filled in three steps: fitString() for every string value (or
+// fitRow()), allocate(), then the put functions (or putRow()).
+class SortKeyTable {
+private:
+    std::vector<SortKey> keys;
+    std::vector<size_t> fieldOffset;      // Start of each key's field within a row key
+    std::vector<size_t> fieldWidth;       // Bytes of each key's field
+    std::vector<std::vector<int> > ranks; // Dictionary ranks of categorical keys
+    size_t width;                         // Bytes per row key, including the row number
+    std::vector<unsigned char> bytes;     // rows * width
+
+    // Write value big-endian into the field (sign bit flipped), then invert if descending
+    void putBits(int row, size_t key, uint64_t value);
+
+public:
+    explicit SortKeyTable(const std::vector<SortKey>& sortKeys);
+
+    // Make room for a string value of this length in a string key's field
+    void fitString(size_t key, size_t length);
+    void fitRow(const Transaction& t);
+
+    // Allocate the keys of rows rows (each row number is written here)
+    void allocate(int rows);
+
+    // Encode one field of a row
+    void putString(int row, size_t key, const char* data, size_t length);
+    void putCode(int row, size_t key, CategoryCode code);
+    void putDouble(int row, size_t key, double value);
+    void putInteger(int row, size_t key, int64_t value); // timestamp, int and bool keys
+    void putRow(int row, const Transaction& t);
+
+    // Number of keys and the column of each
+    size_t keyCount() const { return keys.size(); }
+    int column(size_t key) const { return keys[key].column; }
+
+    // Row numbers in key order: a merge sort in which each comparison is one memcmp
+    std::vector<int> sortedOrder() const;
+};
+
+#endif // SORT_KEY_HPP
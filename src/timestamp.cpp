@@ -0,0 +1,134 @@
+#include "timestamp.hpp"
+
+static const int64_t MICROS_PER_SECOND = 1000000;
+static const int64_t SECONDS_PER_DAY = 86400;
+
+// Value of count decimal digits at p (-1 if any of them is not a digit)
+static inline int readDigits(const char* p, int count) {
+    int value = 0;
+    for (int i = 0; i < count; ++i) {
+        unsigned digit = (unsigned char)p[i] - '0';
+        if (digit > 9) return -1;
+        value = value * 10 + (int)digit;
+    }
+    return value;
+}
+
+static inline bool isLeapYear(int year) {
+    return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+}
+
+static int daysInMonth(int year, int month) {
+    static const int DAYS[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    return (month == 2 && isLeapYear(year)) ? 29 : DAYS[month - 1];
+}
+
+// Days from 1970-01-01 to the given civil date (proleptic Gregorian calendar,
+// computed in 400-year eras as in Howard Hinnant's days_from_civil)
+static int64_t daysFromCivil(int year, int month, int day) {
+    year -= month <= 2;
+    int64_t era = (year >= 0 ? year : year - 399) / 400;
+    int64_t yearOfEra = year - era * 400;
+    int64_t dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    int64_t dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + dayOfEra - 719468;
+}
+
+// Inverse of daysFromCivil
+static void civilFromDays(int64_t days, int& year, int& month, int& day) {
+    days += 719468;
+    int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+    int64_t dayOfEra = days - era * 146097;
+    int64_t yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    int64_t dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    int64_t monthIndex = (5 * dayOfYear + 2) / 153;
+    day = (int)(dayOfYear - (153 * monthIndex + 2) / 5 + 1);
+    month = (int)(monthIndex < 10 ? monthIndex + 3 : monthIndex - 9);
+    year = (int)(yearOfEra + era * 400 + (month <= 2));
+}
+
+// Reads the fixed layout "YYYY-MM-DDTHH:MM:SS" then an optional fraction
+bool parseTimestamp(const char* begin, const char* end, int64_t& micros) {
+    const char* p = begin;
+    if (end - p < 19) return false;
+    if (p[4] != '-' || p[7] != '-' || (p[10] != 'T' && p[10] != ' ')
+        || p[13] != ':' || p[16] != ':') {
+        return false;
+    }
+
+    int year = readDigits(p, 4);
+    int month = readDigits(p + 5, 2);
+    int day = readDigits(p + 8, 2);
+    int hour = readDigits(p + 11, 2);
+    int minute = readDigits(p + 14, 2);
+    int second = readDigits(p + 17, 2);
+    if (year < 0 || month < 1 || month > 12 || day < 1 || day > daysInMonth(year, month)
+        || hour < 0 || hour > 23 || minute < 0 || minute > 59 || second < 0 || second > 59) {
+        return false;
+    }
+    p += 19;
+
+    // fraction digits beyond the first are scaled up to microseconds
+    int fraction = 0;
+    if (p < end) {
+        if (*p != '.') return false;
+        ++p;
+        int digits = (int)(end - p);
+        if (digits < 1 || digits > 6) return false;
+        fraction = readDigits(p, digits);
+        if (fraction < 0) return false;
+        for (int i = digits; i < 6; ++i) fraction *= 10;
+    }
+
+    int64_t seconds = daysFromCivil(year, month, day) * SECONDS_PER_DAY
+                    + hour * 3600 + minute * 60 + second;
+    micros = seconds * MICROS_PER_SECOND + fraction;
+    return true;
+}
+
+// Writes value as exactly count zero-padded digits
+static inline void writeDigits(char* p, int value, int count) {
+    for (int i = count - 1; i >= 0; --i) {
+        p[i] = (char)('0' + value % 10);
+        value /= 10;
+    }
+}
+
+// Splits micros into calendar fields (floor division, so times before 1970 work)
+int formatTimestamp(int64_t micros, char* buffer) {
+    int64_t seconds = micros / MICROS_PER_SECOND;
+    int64_t fraction = micros % MICROS_PER_SECOND;
+    if (fraction < 0) {
+        fraction += MICROS_PER_SECOND;
+        seconds -= 1;
+    }
+    int64_t days = seconds / SECONDS_PER_DAY;
+    int64_t secondOfDay = seconds % SECONDS_PER_DAY;
+    if (secondOfDay < 0) {
+        secondOfDay += SECONDS_PER_DAY;
+        days -= 1;
+    }
+
+    int year, month, day;
+    civilFromDays(days, year, month, day);
+    writeDigits(buffer, year, 4);
+    buffer[4] = '-';
+    writeDigits(buffer + 5, month, 2);
+    buffer[7] = '-';
+    writeDigits(buffer + 8, day, 2);
+    buffer[10] = 'T';
+    writeDigits(buffer + 11, (int)(secondOfDay / 3600), 2);
+    buffer[13] = ':';
+    writeDigits(buffer + 14, (int)(secondOfDay / 60 % 60), 2);
+    buffer[16] = ':';
+    writeDigits(buffer + 17, (int)(secondOfDay % 60), 2);
+    if (fraction == 0) return 19;
+    buffer[19] = '.';
+    writeDigits(buffer + 20, (int)fraction, 6);
+    return TIMESTAMP_TEXT_SIZE;
+}
+
+std::string formatTimestamp(int64_t micros) {
+    char buffer[TIMESTAMP_TEXT_SIZE];
+    return std::string(buffer, formatTimestamp(micros, buffer));
+}
@@ -0,0 +1,28 @@
+#ifndef TIMESTAMP_HPP
+#define TIMESTAMP_HPP
+
+#include <cstdint>
+#include <string>
+
+// Timestamps are stored as microseconds since 1970-01-01T00:00:00 (the CSV
+// times carry no zone, so they are treated as UTC)
+
+// Longest text produced by formatTimestamp ("YYYY-MM-DDTHH:MM:SS.ffffff")
+const int TIMESTAMP_TEXT_SIZE = 26;
+
+// Fixed-format ISO-8601 parser for "YYYY-MM-DDTHH:MM:SS[.f...]" (a space is
+// also accepted in place of 'T', and 1 to 6 fraction digits). Digits are read
+// by position and the date is converted arithmetically, so no strptime, locale
+// or time zone lookup is involved. Returns false if the field is malformed or
+// names an impossible date or time.
+bool parseTimestamp(const char* begin, const char* end, int64_t& micros);
+
+// Write micros as "YYYY-MM-DDTHH:MM:SS.ffffff" into buffer (at least
+// TIMESTAMP_TEXT_SIZE bytes, not null-terminated). The fraction is left out
+// when it is zero, matching the dataset. Returns the number of bytes written.
+int formatTimestamp(int64_t micros, char* buffer);
+
+// Same as above, as an owned string
+std::string formatTimestamp(int64_t micros);
+
+#endif // TIMESTAMP_HPP
@@ -3,29 +3,159 @@
 
 #include <string>
 #include <cctype>
+#include <cstdint>
+#include "dictionary.hpp"
+
+// Column positions in the CSV file, shared by every per-column table
+enum TransactionColumn {
+    COL_TRANSACTION_ID,
+    COL_TIMESTAMP,
+    COL_SENDER_ACCOUNT,
+    COL_RECEIVER_ACCOUNT,
+    COL_AMOUNT,
+    COL_TRANSACTION_TYPE,
+    COL_MERCHANT_CATEGORY,
+    COL_LOCATION,
+    COL_DEVICE_USED,
+    COL_IS_FRAUD,
+    COL_FRAUD_TYPE,
+    COL_TIME_SINCE_LAST_TRANSACTION,
+    COL_SPENDING_DEVIATION,
+    COL_VELOCITY_SCORE,
+    COL_GEO_ANOMALY,
+    COL_PAYMENT_CHANNEL,
+    COL_IP_ADDRESS,
+    COL_DEVICE_HASH,
+    COLUMN_COUNT
+};
+
+// Utility: field name of a column as used in the JSON exports
+inline const char* columnName(int col) {
+    static const char* const NAMES[COLUMN_COUNT] = {
+        "transaction_id", "timestamp", "sender_account", "receiver_account", "amount",
+        "transaction_type", "merchant_category", "location", "device_used", "is_fraud",
+        "fraud_type", "time_since_last_transaction", "spending_deviation", "velocity_score",
+        "geo_anomaly", "payment_channel", "ip_address", "device_hash"
+    };
+    return (col >= 0 && col < COLUMN_COUNT) ? NAMES[col] : "";
+}
+
+// Whether a column is stored as a dictionary code in Transaction
+inline bool isCategorical(int col) {
+    return col == COL_TRANSACTION_TYPE || col == COL_MERCHANT_CATEGORY || col == COL_LOCATION
+        || col == COL_DEVICE_USED || col == COL_PAYMENT_CHANNEL;
+}
+
+// How a column is stored in Transaction and the typed stores
+enum ColumnType {
+    TYPE_STRING,          // std::string
+    TYPE_TIMESTAMP,       // int64_t microseconds since the epoch (see timestamp.hpp)
+    TYPE_CATEGORY,        // CategoryCode into dictionaryFor(col)
+    TYPE_DOUBLE,          // double
+    TYPE_NULLABLE_DOUBLE, // double, NaN when missing
+    TYPE_INT,             // int
+    TYPE_BOOL             // bool
+};
+
+// Utility: storage type of a column
+inline ColumnType columnType(int col) {
+    switch (col) {
+        case COL_TIMESTAMP:
+            return TYPE_TIMESTAMP;
+        case COL_AMOUNT:
+        case COL_SPENDING_DEVIATION:
+        case COL_GEO_ANOMALY:
+            return TYPE_DOUBLE;
+        case COL_TIME_SINCE_LAST_TRANSACTION:
+            return TYPE_NULLABLE_DOUBLE;
+        case COL_VELOCITY_SCORE:
+            return TYPE_INT;
+        case COL_IS_FRAUD:
+            return TYPE_BOOL;
+        default:
+            return isCategorical(col) ? TYPE_CATEGORY : TYPE_STRING;
+    }
+}
+
+// Utility: whether a nullable numeric value is missing
+inline bool isNull(double value) {
+    return value != value; // only NaN compares unequal to itself
+}
+
+// Algorithm used by the stores' sortByLocation (both are stable)
+enum SortStrategy {
+    SORT_MERGE,    // Comparison-based merge sort, O(N log N)
+    SORT_COUNTING  // Counting sort on the location codes, O(N + distinct locations)
+};
+
+// Process-wide dictionary for a categorical column (codes are shared by all stores)
+StringDictionary& dictionaryFor(int col);
 
 // Structure to represent a single financial transaction
 struct Transaction {
     std::string transaction_id;
-    std::string timestamp;
+    int64_t timestamp;               // Microseconds since 1970-01-01 (see timestamp.hpp)
     std::string sender_account;
     std::string receiver_account;
     double amount;
-    std::string transaction_type;
-    std::string merchant_category;
-    std::string location;
-    std::string device_used;
-    std::string is_fraud;
+    CategoryCode transaction_type;   // Code in dictionaryFor(COL_TRANSACTION_TYPE)
+    CategoryCode merchant_category;  // Code in dictionaryFor(COL_MERCHANT_CATEGORY)
+    CategoryCode location;           // Code in dictionaryFor(COL_LOCATION)
+    CategoryCode device_used;        // Code in dictionaryFor(COL_DEVICE_USED)
+    bool is_fraud;
     std::string fraud_type;
-    std::string time_since_last_transaction;
-    std::string spending_deviation;
-    std::string velocity_score;
-    std::string geo_anomaly;
-    std::string payment_channel;
+    double time_since_last_transaction; // NaN when the CSV field is empty (see isNull)
+    double spending_deviation;
+    int velocity_score;
+    double geo_anomaly;
+    CategoryCode payment_channel;    // Code in dictionaryFor(COL_PAYMENT_CHANNEL)
     std::string ip_address;
     std::string device_hash;
+
+    // Decoded categorical values
+    const std::string& transactionTypeName() const { return dictionaryFor(COL_TRANSACTION_TYPE).lookup(transaction_type); }
+    const std::string& merchantCategoryName() const { return dictionaryFor(COL_MERCHANT_CATEGORY).lookup(merchant_category); }
+    const std::string& locationName() const { return dictionaryFor(COL_LOCATION).lookup(location); }
+    const std::string& deviceUsedName() const { return dictionaryFor(COL_DEVICE_USED).lookup(device_used); }
+    const std::string& paymentChannelName() const { return dictionaryFor(COL_PAYMENT_CHANNEL).lookup(payment_channel); }
+
+    // Members by column, for code that handles any column (col must have the
+    // matching columnType)
+    const std::string& stringValue(int col) const;  // TYPE_STRING
+    CategoryCode categoryValue(int col) const;      // TYPE_CATEGORY
+    double doubleValue(int col) const;              // TYPE_DOUBLE, TYPE_NULLABLE_DOUBLE
 };
 
+inline const std::string& Transaction::stringValue(int col) const {
+    switch (col) {
+        case COL_TRANSACTION_ID: return transaction_id;
+        case COL_SENDER_ACCOUNT: return sender_account;
+        case COL_RECEIVER_ACCOUNT: return receiver_account;
+        case COL_FRAUD_TYPE: return fraud_type;
+        case COL_IP_ADDRESS: return ip_address;
+        default: return device_hash;
+    }
+}
+
+inline CategoryCode Transaction::categoryValue(int col) const {
+    switch (col) {
+        case COL_TRANSACTION_TYPE: return transaction_type;
+        case COL_MERCHANT_CATEGORY: return merchant_category;
+        case COL_LOCATION: return location;
+        case COL_DEVICE_USED: return device_used;
+        default: return payment_channel;
+    }
+}
+
+inline double Transaction::doubleValue(int col) const {
+    switch (col) {
+        case COL_AMOUNT: return amount;
+        case COL_TIME_SINCE_LAST_TRANSACTION: return time_since_last_transaction;
+        case COL_SPENDING_DEVIATION: return spending_deviation;
+        default: return geo_anomaly;
+    }
+}
+
 // Utility: convert string to lowercase for case-insensitive comparison
 inline std::string toLower(const std::string& str) {
     std::string result = "";
@@ -42,4 +172,34 @@ inline std::string trim(const std::string& s) {
     return (start == std::string::npos) ? "" : s.substr(start, end - start + 1);
 }
 
+// Utility: whitespace trimmed from CSV fields, as in trim()
+inline bool isFieldSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+// Utility: narrow [begin, end) to the value of a CSV field without copying. A
+// field in double quotes (RFC 4180) loses its outer quotes and surrounding
+// whitespace, and the quotes inside it stay doubled (see appendUnquoted);
+// other fields are trimmed like trim().
+inline void unquoteSpan(const char*& begin, const char*& end) {
+    while (begin < end && isFieldSpace(*begin)) ++begin;
+    while (end > begin && isFieldSpace(end[-1])) --end;
+    if (end - begin >= 2 && *begin == '"' && end[-1] == '"') {
+        ++begin;
+        --end;
+        return;
+    }
+    while (begin < end && (*begin == '"' || isFieldSpace(*begin))) ++begin;
+    while (end > begin && (end[-1] == '"' || isFieldSpace(end[-1]))) --end;
+}
+
+// Utility: append the bytes of a field narrowed by unquoteSpan, collapsing
+// each doubled quote
+inline void appendUnquoted(std::string& out, const char* begin, const char* end) {
+    for (const char* p = begin; p < end; ++p) {
+        out.push_back(*p);
+        if (*p == '"' && p + 1 < end && p[1] == '"') ++p;
+    }
+}
+
 #endif // TRANSACTION_HPP 
\ No newline at end of file
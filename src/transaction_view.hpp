@@ -0,0 +1,135 @@
+#ifndef TRANSACTION_VIEW_HPP
+#define TRANSACTION_VIEW_HPP
+
+#include <string>
+#include <cstring>
+#include <cstdint>
+#include <ostream>
+#include <limits>
+#include "transaction.hpp"
+#include "numeric_parse.hpp"
+#include "timestamp.hpp"
+
+// Non-owning reference to a run of bytes (a minimal C++11 string_view)
+struct StringRef {
+    const char* data;
+    size_t size;
+
+    // Byte-wise equality with an owned string
+    bool operator==(const std::string& other) const {
+        return size == other.size() && std::memcmp(data, other.data(), size) == 0;
+    }
+    bool operator!=(const std::string& other) const {
+        return !(*this == other);
+    }
+
+    // Copy into an owned string
+    std::string str() const {
+        return std::string(data, size);
+    }
+};
+
+// Print the referenced bytes
+inline std::ostream& operator<<(std::ostream& out, const StringRef& ref) {
+    return out.write(ref.data, ref.size);
+}
+
+// Position of one unquoted field relative to the start of its row
+struct FieldRef {
+    uint16_t offset;
+    uint16_t length;
+};
+
+// Zero-copy transaction: every field is an (offset, length) pair into the
+// retained input buffer, so a row costs under 100 bytes and no heap allocations.
+// Only amount is parsed at load time because it is always used as a number.
+struct TransactionView {
+    const char* row;                  // Start of the row in the input buffer
+    FieldRef fields[COLUMN_COUNT];    // Unquoted field positions (rows are < 64 KB)
+    double amount;
+
+    // Bytes of one column (quotes inside a quoted value are still doubled)
+    StringRef field(int col) const {
+        StringRef ref = { row + fields[col].offset, fields[col].length };
+        return ref;
+    }
+
+    // Owned copy of one column, with doubled quotes collapsed
+    std::string str(int col) const {
+        const char* begin = row + fields[col].offset;
+        const char* end = begin + fields[col].length;
+        if (std::memchr(begin, '"', fields[col].length) == nullptr) return std::string(begin, end);
+        std::string value;
+        appendUnquoted(value, begin, end);
+        return value;
+    }
+
+    // Dictionary code of a categorical column (interned if not seen before)
+    CategoryCode code(int col) const {
+        const char* begin = row + fields[col].offset;
+        if (std::memchr(begin, '"', fields[col].length) == nullptr) {
+            return dictionaryFor(col).intern(begin, fields[col].length);
+        }
+        return dictionaryFor(col).intern(str(col));
+    }
+
+    // Numeric value of a column, parsed on demand (NaN if empty or malformed)
+    double number(int col) const {
+        const char* begin = row + fields[col].offset;
+        double value;
+        if (!parseDouble(begin, begin + fields[col].length, value)) {
+            value = std::numeric_limits<double>::quiet_NaN();
+        }
+        return value;
+    }
+
+    // Timestamp in epoch microseconds, parsed on demand (0 if malformed)
+    int64_t time() const {
+        const char* begin = row + fields[COL_TIMESTAMP].offset;
+        int64_t micros = 0;
+        if (!parseTimestamp(begin, begin + fields[COL_TIMESTAMP].length, micros)) micros = 0;
+        return micros;
+    }
+
+    // velocity_score parsed on demand (0 if malformed; loadTransactionViews
+    // rejects such rows)
+    int velocityScore() const {
+        const char* begin = row + fields[COL_VELOCITY_SCORE].offset;
+        int value = 0;
+        if (!parseInt(begin, begin + fields[COL_VELOCITY_SCORE].length, value)) value = 0;
+        return value;
+    }
+
+    // is_fraud parsed on demand (malformed values count as not fraudulent)
+    bool isFraud() const {
+        const char* begin = row + fields[COL_IS_FRAUD].offset;
+        bool value = false;
+        return parseBool(begin, begin + fields[COL_IS_FRAUD].length, value) && value;
+    }
+
+    // Build an owning Transaction with the same values
+    Transaction materialize() const {
+        Transaction t;
+        t.transaction_id = str(COL_TRANSACTION_ID);
+        t.timestamp = time();
+        t.sender_account = str(COL_SENDER_ACCOUNT);
+        t.receiver_account = str(COL_RECEIVER_ACCOUNT);
+        t.amount = amount;
+        t.transaction_type = code(COL_TRANSACTION_TYPE);
+        t.merchant_category = code(COL_MERCHANT_CATEGORY);
+        t.location = code(COL_LOCATION);
+        t.device_used = code(COL_DEVICE_USED);
+        t.is_fraud = isFraud();
+        t.fraud_type = str(COL_FRAUD_TYPE);
+        t.time_since_last_transaction = number(COL_TIME_SINCE_LAST_TRANSACTION);
+        t.spending_deviation = number(COL_SPENDING_DEVIATION);
+        t.velocity_score = velocityScore();
+        t.geo_anomaly = number(COL_GEO_ANOMALY);
+        t.payment_channel = code(COL_PAYMENT_CHANNEL);
+        t.ip_address = str(COL_IP_ADDRESS);
+        t.device_hash = str(COL_DEVICE_HASH);
+        return t;
+    }
+};
+
+#endif // TRANSACTION_VIEW_HPP
@@ -0,0 +1,136 @@
+#include "view_store.hpp"
+#include <iostream>
+
+// Constructor: reserves room for max_size views
+ViewStore::ViewStore(int max_size) {
+    views.reserve(max_size > 0 ? max_size : 0);
+}
+
+// Attaches the buffer the views point into
+void ViewStore::setBuffer(const std::shared_ptr<const MappedFile>& input) {
+    buffer = input;
+}
+
+// Adds a view to the end of the store
+void ViewStore::addView(const TransactionView& view) {
+    views.push_back(view);
+}
+
+// Returns the view at index
+const TransactionView& ViewStore::at(int index) const {
+    return views[index];
+}
+
+// Returns the current number of views
+int ViewStore::getSize() const {
+    return (int)views.size();
+}
+
+// Prints one row in the same format as the other stores
+static void printView(const TransactionView& v) {
+    std::cout << "ID: " << v.field(COL_TRANSACTION_ID)
+              << ", Date: " << v.field(COL_TIMESTAMP)
+              << ", Amount: " << v.amount
+              << ", Type: " << v.field(COL_TRANSACTION_TYPE)
+              << ", Location: " << v.field(COL_LOCATION)
+              << ", Channel: " << v.field(COL_PAYMENT_CHANNEL)
+              << std::endl;
+}
+
+// Displays the first transactions and optionally all of them
+void ViewStore::display() const {
+    std::cout << "\n--- Transactions (Zero-Copy Views) ---\n";
+    int size = getSize();
+
+    // Show first 10 transactions
+    int displayCount = (size > 10) ? 10 : size;
+    for (int i = 0; i < displayCount; ++i) {
+        printView(views[i]);
+    }
+
+    // If there are more transactions, ask user if they want to see all
+    if (size > 10) {
+        std::cout << "... and " << (size - 10) << " more transactions\n";
+        std::cout << "Total: " << size << " transactions\n";
+        std::cout << "Show all transactions? (y/n): ";
+
+        char choice;
+        std::cin >> choice;
+
+        if (choice == 'y' || choice == 'Y') {
+            std::cout << "\n--- ALL TRANSACTIONS (Zero-Copy Views) ---\n";
+            for (int i = 0; i < size; ++i) {
+                printView(views[i]);
+            }
+            std::cout << "Total: " << size << " transactions\n";
+        }
+    } else {
+        std::cout << "Total: " << size << " transactions\n";
+    }
+
+    std::cout << "-------------------\n";
+}
+
+// Groups views by payment channel (copies views, not strings)
+ViewStore ViewStore::groupByPaymentChannel(const std::string& channel) const {
+    ViewStore grouped(0);
+    grouped.setBuffer(buffer);
+    for (size_t i = 0; i < views.size(); ++i) {
+        if (views[i].field(COL_PAYMENT_CHANNEL) == channel) {
+            grouped.addView(views[i]);
+        }
+    }
+    return grouped;
+}
+
+// Searches views by transaction type (copies views, not strings)
+ViewStore ViewStore::searchByTransactionType(const std::string& type) const {
+    ViewStore found(0);
+    found.setBuffer(buffer);
+    for (size_t i = 0; i < views.size(); ++i) {
+        if (views[i].field(COL_TRANSACTION_TYPE) == type) {
+            found.addView(views[i]);
+        }
+    }
+    return found;
+}
+
+// Gets all fraudulent transactions
+ViewStore ViewStore::getFraudulentTransactions() const {
+    ViewStore fraudulent(0);
+    fraudulent.setBuffer(buffer);
+    for (size_t i = 0; i < views.size(); ++i) {
+        if (views[i].isFraud()) {
+            fraudulent.addView(views[i]);
+        }
+    }
+    return fraudulent;
+}
+
+// Exports transactions to JSON format
+nlohmann::json ViewStore::toJSON() const {
+    nlohmann::json j_array = nlohmann::json::array();
+    for (size_t i = 0; i < views.size(); ++i) {
+        const TransactionView& v = views[i];
+        nlohmann::json j_trans = nlohmann::json::object();
+        for (int col = 0; col < COLUMN_COUNT; ++col) {
+            switch (columnType(col)) {
+                case TYPE_DOUBLE:
+                case TYPE_NULLABLE_DOUBLE:
+                    j_trans[columnName(col)] = (col == COL_AMOUNT) ? v.amount : v.number(col);
+                    break;
+                case TYPE_INT:
+                    j_trans[columnName(col)] = v.velocityScore();
+                    break;
+                case TYPE_BOOL:
+                    j_trans[columnName(col)] = v.isFraud();
+                    break;
+                default:
+                    j_trans[columnName(col)] = v.str(col);
+                    break;
+            }
+        }
+        j_array.push_back(j_trans);
+    }
+    return j_array;
+}
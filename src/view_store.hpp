@@ -0,0 +1,52 @@
+#ifndef VIEW_STORE_HPP
+#define VIEW_STORE_HPP
+
+#include <string>
+#include <vector>
+#include <memory>
+#include "../lib/json.hpp" // For JSON export
+#include "transaction_view.hpp"
+#include "mapped_file.hpp"
+
+// Array-based store of zero-copy TransactionViews.
+// Offers the same operations as ArrayStore, but rows reference a shared input
+// buffer instead of owning 17 strings each. Filtered stores share the buffer
+// too, so filtering copies small views and never materializes strings.
+class ViewStore {
+private:
+    std::shared_ptr<const MappedFile> buffer; // Keeps the bytes behind the views alive
+    std::vector<TransactionView> views;       // Rows in load order
+
+public:
+    // Constructor: empty store with room for max_size views
+    ViewStore(int max_size = 1000);
+
+    // Attach the buffer the views point into (shared with filtered stores)
+    void setBuffer(const std::shared_ptr<const MappedFile>& input);
+
+    // Add a view (it must point into the attached buffer)
+    void addView(const TransactionView& view);
+
+    // Access a row
+    const TransactionView& at(int index) const;
+
+    // Group views by payment channel (returns a new ViewStore on the same buffer)
+    ViewStore groupByPaymentChannel(const std::string& channel) const;
+
+    // Search for views by type (returns a new ViewStore on the same buffer)
+    ViewStore searchByTransactionType(const std::string& type) const;
+
+    // Get fraudulent transactions (returns a new ViewStore on the same buffer)
+    ViewStore getFraudulentTransactions() const;
+
+    // Export transactions to JSON
+    nlohmann::json toJSON() const;
+
+    // Display transactions to console
+    void display() const;
+
+    // Get the number of transactions
+    int getSize() const;
+};
+
+#endif // VIEW_STORE_HPP